@@ -339,10 +339,42 @@
     #define configUSE_EVENT_GROUPS    1
 #endif
 
+/* Set configUSE_EVENT_GROUP_WAITER_INDEX to 1 to keep the tasks blocked on an
+ * event group in one list per event bit, so xEventGroupSetBits() only examines
+ * tasks waiting for one of the bits being set.  Costs one list per usable event
+ * bit in each event group. */
+#ifndef configUSE_EVENT_GROUP_WAITER_INDEX
+    #define configUSE_EVENT_GROUP_WAITER_INDEX    0
+#endif
+
+/* The number of event bits available to the application.  The top eight bits
+ * of the configTICK_TYPE_WIDTH_IN_BITS wide value are used for control bits
+ * (see eventEVENT_BITS_CONTROL_BYTES), whatever the size of TickType_t on the
+ * port. */
+#if ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS )
+    #define eventNUMBER_OF_EVENT_BITS    8U
+#elif ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS )
+    #define eventNUMBER_OF_EVENT_BITS    24U
+#else
+    #define eventNUMBER_OF_EVENT_BITS    56U
+#endif
+
 #ifndef configUSE_STREAM_BUFFERS
     #define configUSE_STREAM_BUFFERS    1
 #endif
 
+/* Set configUSE_SPSC_QUEUES to 1 to include the single producer, single
+ * consumer queues in spsc_queue.c. */
+#ifndef configUSE_SPSC_QUEUES
+    #define configUSE_SPSC_QUEUES    0
+#endif
+
+/* Set configUSE_LIGHTWEIGHT_SYNC to 1 to include the task notification based
+ * semaphores and events in lightweight_sync.c. */
+#ifndef configUSE_LIGHTWEIGHT_SYNC
+    #define configUSE_LIGHTWEIGHT_SYNC    0
+#endif
+
 #ifndef configUSE_DAEMON_TASK_STARTUP_HOOK
     #define configUSE_DAEMON_TASK_STARTUP_HOOK    0
 #endif
@@ -543,6 +575,27 @@
 
 #endif /* configUSE_TIMERS */
 
+/* Set configUSE_TIMER_WHEEL to 1 to hold active software timers in a
+ * hierarchical timing wheel instead of a sorted list, making start, stop and
+ * reset O(1) for the timer service task.  Timers whose expiry time is beyond
+ * the next tick count overflow are kept in an unsorted list and moved into the
+ * wheel when the tick count overflows. */
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+/* Set configUSE_TIMER_COMMAND_BATCHING to 1 to have the timer service task
+ * take up to configTIMER_COMMAND_BATCH_LENGTH commands off the timer queue at
+ * a time, skipping a start or reset that a later command in the batch makes
+ * redundant, and to provide xTimerResetMultiple(). */
+#ifndef configUSE_TIMER_COMMAND_BATCHING
+    #define configUSE_TIMER_COMMAND_BATCHING    0
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_LENGTH
+    #define configTIMER_COMMAND_BATCH_LENGTH    8
+#endif
+
 #ifndef portHAS_NESTED_INTERRUPTS
     #if defined( portSET_INTERRUPT_MASK_FROM_ISR ) && defined( portCLEAR_INTERRUPT_MASK_FROM_ISR )
         #define portHAS_NESTED_INTERRUPTS    1
@@ -579,6 +632,12 @@
     #define portCLEAN_UP_TCB( pxTCB )    ( void ) ( pxTCB )
 #endif
 
+/* Clears every ready priority recorded with portRECORD_READY_PRIORITY(),
+ * including any state the port keeps outside uxReadyPriorities. */
+#ifndef portRESET_ALL_READY_PRIORITIES
+    #define portRESET_ALL_READY_PRIORITIES( uxReadyPriorities )    ( ( uxReadyPriorities ) = ( UBaseType_t ) 0U )
+#endif
+
 #ifndef portPRE_TASK_DELETE_HOOK
     #define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxYieldPending )
 #endif
@@ -591,6 +650,15 @@
     #define portTASK_SWITCH_HOOK( pxTCB )    ( void ) ( pxTCB )
 #endif
 
+/* A port whose tasks do not run on the stack allocated by the kernel can
+ * reduce the depth xTaskCreate() allocates with portTASK_STACK_DEPTH(). It
+ * should then also define portGET_STACK_HIGH_WATER_MARK( pxTCB ) to return,
+ * in words, the stack the task has never used, as the kernel can no longer
+ * find that by looking for tskSTACK_FILL_BYTE. */
+#ifndef portTASK_STACK_DEPTH
+    #define portTASK_STACK_DEPTH( uxStackDepth )    ( uxStackDepth )
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
     #define configQUEUE_REGISTRY_SIZE    0U
 #endif
@@ -605,6 +673,46 @@
     #define configUSE_MINI_LIST_ITEM    1
 #endif
 
+/* Set configUSE_DELAYED_LIST_INDEX to 1 to keep a timing wheel of insertion
+ * hints for the delayed task lists. Blocking a task then starts the search
+ * for its position in wake time order from a task that wakes shortly before
+ * it rather than from the head of the list. Each of the
+ * configDELAYED_LIST_INDEX_SLOTS slots (a power of two) covers
+ * 2 ^ configDELAYED_LIST_INDEX_SHIFT ticks. */
+#ifndef configUSE_DELAYED_LIST_INDEX
+    #define configUSE_DELAYED_LIST_INDEX    0
+#endif
+
+#ifndef configDELAYED_LIST_INDEX_SLOTS
+    #define configDELAYED_LIST_INDEX_SLOTS    256U
+#endif
+
+#ifndef configDELAYED_LIST_INDEX_SHIFT
+    #define configDELAYED_LIST_INDEX_SHIFT    0U
+#endif
+
+#if ( ( configDELAYED_LIST_INDEX_SLOTS & ( configDELAYED_LIST_INDEX_SLOTS - 1U ) ) != 0U )
+    #error configDELAYED_LIST_INDEX_SLOTS must be a power of two
+#endif
+
+/* Set configUSE_EVENT_LIST_INDEX to 1 to index the lists of tasks waiting on a
+ * queue, semaphore or mutex by priority.  Each list keeps a bitmap of the
+ * priorities it holds waiters of, and the kernel keeps the last waiter of each
+ * (list, priority) pair in a table of configEVENT_LIST_INDEX_SLOTS entries (a
+ * power of two), so a task that blocks is linked in after the nearest waiter
+ * of equal or higher priority without walking the list. */
+#ifndef configUSE_EVENT_LIST_INDEX
+    #define configUSE_EVENT_LIST_INDEX    0
+#endif
+
+#ifndef configEVENT_LIST_INDEX_SLOTS
+    #define configEVENT_LIST_INDEX_SLOTS    64U
+#endif
+
+#if ( ( configEVENT_LIST_INDEX_SLOTS & ( configEVENT_LIST_INDEX_SLOTS - 1U ) ) != 0U )
+    #error configEVENT_LIST_INDEX_SLOTS must be a power of two
+#endif
+
 #ifndef portPOINTER_SIZE_TYPE
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
@@ -1054,6 +1162,54 @@
     #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceBLOCKING_ON_SPSC_QUEUE_SEND
+    #define traceBLOCKING_ON_SPSC_QUEUE_SEND( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_SPSC_QUEUE_RECEIVE
+    #define traceBLOCKING_ON_SPSC_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceSPSC_QUEUE_SEND
+    #define traceSPSC_QUEUE_SEND( xQueue )
+#endif
+
+#ifndef traceSPSC_QUEUE_SEND_FAILED
+    #define traceSPSC_QUEUE_SEND_FAILED( xQueue )
+#endif
+
+#ifndef traceSPSC_QUEUE_RECEIVE
+    #define traceSPSC_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceSPSC_QUEUE_RECEIVE_FAILED
+    #define traceSPSC_QUEUE_RECEIVE_FAILED( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_LIGHT_SYNC_WAIT
+    #define traceBLOCKING_ON_LIGHT_SYNC_WAIT( xSync )
+#endif
+
+#ifndef traceBLOCKING_ON_LIGHT_SYNC_FALLBACK
+    #define traceBLOCKING_ON_LIGHT_SYNC_FALLBACK( xSync )
+#endif
+
+#ifndef traceLIGHT_SYNC_WAIT
+    #define traceLIGHT_SYNC_WAIT( xSync )
+#endif
+
+#ifndef traceLIGHT_SYNC_WAIT_FAILED
+    #define traceLIGHT_SYNC_WAIT_FAILED( xSync )
+#endif
+
+#ifndef traceLIGHT_SYNC_SIGNAL
+    #define traceLIGHT_SYNC_SIGNAL( xSync )
+#endif
+
+#ifndef traceLIGHT_SYNC_SIGNAL_FAILED
+    #define traceLIGHT_SYNC_SIGNAL_FAILED( xSync )
+#endif
+
 #ifndef traceENTER_xEventGroupCreateStatic
     #define traceENTER_xEventGroupCreateStatic( pxEventGroupBuffer )
 #endif
@@ -1302,6 +1458,54 @@
     #define traceRETURN_xQueueReceive( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueSendMultiple
+    #define traceENTER_xQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueSendMultiple
+    #define traceRETURN_xQueueSendMultiple( uxItemsSent )
+#endif
+
+#ifndef traceENTER_xQueueReceiveMultiple
+    #define traceENTER_xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveMultiple
+    #define traceRETURN_xQueueReceiveMultiple( uxItemsReceived )
+#endif
+
+#ifndef traceENTER_xQueueReserve
+    #define traceENTER_xQueueReserve( xQueue, ppvSlot, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReserve
+    #define traceRETURN_xQueueReserve( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueCommit
+    #define traceENTER_xQueueCommit( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCommit
+    #define traceRETURN_xQueueCommit( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueAcquire
+    #define traceENTER_xQueueAcquire( xQueue, ppvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueAcquire
+    #define traceRETURN_xQueueAcquire( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueRelease
+    #define traceENTER_xQueueRelease( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueRelease
+    #define traceRETURN_xQueueRelease( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueSemaphoreTake
     #define traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait )
 #endif
@@ -1374,6 +1578,14 @@
     #define traceRETURN_uxQueueGetQueueNumber( uxQueueNumber )
 #endif
 
+#ifndef traceENTER_xQueueGetHighestReceiverPriority
+    #define traceENTER_xQueueGetHighestReceiverPriority( xQueue, puxPriority )
+#endif
+
+#ifndef traceRETURN_xQueueGetHighestReceiverPriority
+    #define traceRETURN_xQueueGetHighestReceiverPriority( xReturn )
+#endif
+
 #ifndef traceENTER_vQueueSetQueueNumber
     #define traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber )
 #endif
@@ -1574,6 +1786,14 @@
     #define traceRETURN_xTimerGenericCommandFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xTimerResetMultiple
+    #define traceENTER_xTimerResetMultiple( pxTimers, uxTimerCount )
+#endif
+
+#ifndef traceRETURN_xTimerResetMultiple
+    #define traceRETURN_xTimerResetMultiple( xReturn )
+#endif
+
 #ifndef traceENTER_xTimerGetTimerDaemonTaskHandle
     #define traceENTER_xTimerGetTimerDaemonTaskHandle()
 #endif
@@ -2074,6 +2294,14 @@
     #define traceRETURN_vTaskPlaceOnEventList()
 #endif
 
+#ifndef traceENTER_vTaskPlaceOnIndexedEventList
+    #define traceENTER_vTaskPlaceOnIndexedEventList( pxEventList, pxIndex, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_vTaskPlaceOnIndexedEventList
+    #define traceRETURN_vTaskPlaceOnIndexedEventList()
+#endif
+
 #ifndef traceENTER_vTaskPlaceOnUnorderedEventList
     #define traceENTER_vTaskPlaceOnUnorderedEventList( pxEventList, xItemValue, xTicksToWait )
 #endif
@@ -2322,6 +2550,22 @@
     #define traceRETURN_uxTaskResetEventItemValue( uxReturn )
 #endif
 
+#ifndef traceENTER_vTaskSetLightSyncWaiter
+    #define traceENTER_vTaskSetLightSyncWaiter( pxWaiterRecord, uxIndexToWaitOn )
+#endif
+
+#ifndef traceRETURN_vTaskSetLightSyncWaiter
+    #define traceRETURN_vTaskSetLightSyncWaiter()
+#endif
+
+#ifndef traceENTER_pxTaskGetLightSyncWaiter
+    #define traceENTER_pxTaskGetLightSyncWaiter()
+#endif
+
+#ifndef traceRETURN_pxTaskGetLightSyncWaiter
+    #define traceRETURN_pxTaskGetLightSyncWaiter( pxReturn )
+#endif
+
 #ifndef traceENTER_pvTaskIncrementMutexHeldCount
     #define traceENTER_pvTaskIncrementMutexHeldCount()
 #endif
@@ -2418,6 +2662,54 @@
     #define traceRETURN_ulTaskGetIdleRunTimePercent( ulReturn )
 #endif
 
+#ifndef traceENTER_uxTaskGetSystemSnapshot
+    #define traceENTER_uxTaskGetSystemSnapshot( pxTaskStatusArray, uxArraySize, pulTotalRunTime )
+#endif
+
+#ifndef traceRETURN_uxTaskGetSystemSnapshot
+    #define traceRETURN_uxTaskGetSystemSnapshot( uxTask )
+#endif
+
+#ifndef traceENTER_uxTaskGetSnapshotMissedTasks
+    #define traceENTER_uxTaskGetSnapshotMissedTasks()
+#endif
+
+#ifndef traceRETURN_uxTaskGetSnapshotMissedTasks
+    #define traceRETURN_uxTaskGetSnapshotMissedTasks( uxMissedTasks )
+#endif
+
+#ifndef traceENTER_vTaskGetSchedulingLatency
+    #define traceENTER_vTaskGetSchedulingLatency( xTask, pxHistogram )
+#endif
+
+#ifndef traceRETURN_vTaskGetSchedulingLatency
+    #define traceRETURN_vTaskGetSchedulingLatency()
+#endif
+
+#ifndef traceENTER_vTaskResetSchedulingLatency
+    #define traceENTER_vTaskResetSchedulingLatency( xTask )
+#endif
+
+#ifndef traceRETURN_vTaskResetSchedulingLatency
+    #define traceRETURN_vTaskResetSchedulingLatency()
+#endif
+
+#ifndef traceENTER_ulTaskGetSchedulingLatencyBucketValue
+    #define traceENTER_ulTaskGetSchedulingLatencyBucketValue( uxBucket )
+#endif
+
+#ifndef traceRETURN_ulTaskGetSchedulingLatencyBucketValue
+    #define traceRETURN_ulTaskGetSchedulingLatencyBucketValue( ulReturn )
+#endif
+
+#ifndef traceENTER_ulTaskGetSchedulingLatencyPercentile
+    #define traceENTER_ulTaskGetSchedulingLatencyPercentile( pxHistogram, uxPercentile )
+#endif
+
+#ifndef traceRETURN_ulTaskGetSchedulingLatencyPercentile
+    #define traceRETURN_ulTaskGetSchedulingLatencyPercentile( ulReturn )
+#endif
+
 #ifndef traceENTER_xTaskGetMPUSettings
     #define traceENTER_xTaskGetMPUSettings( xTask )
 #endif
@@ -2522,6 +2814,54 @@
     #define traceRETURN_xStreamBufferReceive( xReceivedLength )
 #endif
 
+#ifndef traceENTER_xStreamBufferSendFragments
+    #define traceENTER_xStreamBufferSendFragments( xStreamBuffer, pxFragments, uxFragmentCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSendFragments
+    #define traceRETURN_xStreamBufferSendFragments( xReturn )
+#endif
+
+#ifndef traceENTER_uxStreamBufferReceiveMessages
+    #define traceENTER_uxStreamBufferReceiveMessages( xStreamBuffer, pxMessages, uxMaxMessages, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxStreamBufferReceiveMessages
+    #define traceRETURN_uxStreamBufferReceiveMessages( uxReceived )
+#endif
+
+#ifndef traceENTER_xStreamBufferGetReadSpan
+    #define traceENTER_xStreamBufferGetReadSpan( xStreamBuffer, pxSpans, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferGetReadSpan
+    #define traceRETURN_xStreamBufferGetReadSpan( xBytesAvailable )
+#endif
+
+#ifndef traceENTER_xStreamBufferConsume
+    #define traceENTER_xStreamBufferConsume( xStreamBuffer, xBytesConsumed )
+#endif
+
+#ifndef traceRETURN_xStreamBufferConsume
+    #define traceRETURN_xStreamBufferConsume( xBytesConsumed )
+#endif
+
+#ifndef traceENTER_xStreamBufferGetWriteSpan
+    #define traceENTER_xStreamBufferGetWriteSpan( xStreamBuffer, pxSpans, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferGetWriteSpan
+    #define traceRETURN_xStreamBufferGetWriteSpan( xSpace )
+#endif
+
+#ifndef traceENTER_xStreamBufferCommit
+    #define traceENTER_xStreamBufferCommit( xStreamBuffer, xBytesWritten )
+#endif
+
+#ifndef traceRETURN_xStreamBufferCommit
+    #define traceRETURN_xStreamBufferCommit( xBytesWritten )
+#endif
+
 #ifndef traceENTER_xStreamBufferNextMessageLengthBytes
     #define traceENTER_xStreamBufferNextMessageLengthBytes( xStreamBuffer )
 #endif
@@ -2610,6 +2950,150 @@
     #define traceRETURN_ucStreamBufferGetStreamBufferType( ucStreamBufferType )
 #endif
 
+#ifndef traceENTER_xSpscQueueCreate
+    #define traceENTER_xSpscQueueCreate( uxQueueLength, uxItemSize )
+#endif
+
+#ifndef traceRETURN_xSpscQueueCreate
+    #define traceRETURN_xSpscQueueCreate( xReturn )
+#endif
+
+#ifndef traceENTER_xSpscQueueCreateStatic
+    #define traceENTER_xSpscQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xSpscQueueCreateStatic
+    #define traceRETURN_xSpscQueueCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vSpscQueueDelete
+    #define traceENTER_vSpscQueueDelete( xQueue )
+#endif
+
+#ifndef traceRETURN_vSpscQueueDelete
+    #define traceRETURN_vSpscQueueDelete()
+#endif
+
+#ifndef traceENTER_xSpscQueueSend
+    #define traceENTER_xSpscQueueSend( xQueue, pvItemToQueue, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xSpscQueueSend
+    #define traceRETURN_xSpscQueueSend( xReturn )
+#endif
+
+#ifndef traceENTER_xSpscQueueSendFromISR
+    #define traceENTER_xSpscQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xSpscQueueSendFromISR
+    #define traceRETURN_xSpscQueueSendFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xSpscQueueReceive
+    #define traceENTER_xSpscQueueReceive( xQueue, pvBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xSpscQueueReceive
+    #define traceRETURN_xSpscQueueReceive( xReturn )
+#endif
+
+#ifndef traceENTER_xSpscQueueReceiveFromISR
+    #define traceENTER_xSpscQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xSpscQueueReceiveFromISR
+    #define traceRETURN_xSpscQueueReceiveFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_uxSpscQueueMessagesWaiting
+    #define traceENTER_uxSpscQueueMessagesWaiting( xQueue )
+#endif
+
+#ifndef traceRETURN_uxSpscQueueMessagesWaiting
+    #define traceRETURN_uxSpscQueueMessagesWaiting( uxReturn )
+#endif
+
+#ifndef traceENTER_uxSpscQueueSpacesAvailable
+    #define traceENTER_uxSpscQueueSpacesAvailable( xQueue )
+#endif
+
+#ifndef traceRETURN_uxSpscQueueSpacesAvailable
+    #define traceRETURN_uxSpscQueueSpacesAvailable( uxReturn )
+#endif
+
+#ifndef traceENTER_vSpscQueueSetNotificationIndex
+    #define traceENTER_vSpscQueueSetNotificationIndex( xQueue, uxNotificationIndex )
+#endif
+
+#ifndef traceRETURN_vSpscQueueSetNotificationIndex
+    #define traceRETURN_vSpscQueueSetNotificationIndex()
+#endif
+
+#ifndef traceENTER_xLightSyncGenericCreate
+    #define traceENTER_xLightSyncGenericCreate( uxMaxCount, uxInitialCount, ucSyncType )
+#endif
+
+#ifndef traceRETURN_xLightSyncGenericCreate
+    #define traceRETURN_xLightSyncGenericCreate( pxNewSync )
+#endif
+
+#ifndef traceENTER_xLightSyncGenericCreateStatic
+    #define traceENTER_xLightSyncGenericCreateStatic( uxMaxCount, uxInitialCount, ucSyncType, pxStaticSync )
+#endif
+
+#ifndef traceRETURN_xLightSyncGenericCreateStatic
+    #define traceRETURN_xLightSyncGenericCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vLightSyncDelete
+    #define traceENTER_vLightSyncDelete( xSync )
+#endif
+
+#ifndef traceRETURN_vLightSyncDelete
+    #define traceRETURN_vLightSyncDelete()
+#endif
+
+#ifndef traceENTER_xLightSyncWait
+    #define traceENTER_xLightSyncWait( xSync, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xLightSyncWait
+    #define traceRETURN_xLightSyncWait( xReturn )
+#endif
+
+#ifndef traceENTER_xLightSyncSignal
+    #define traceENTER_xLightSyncSignal( xSync )
+#endif
+
+#ifndef traceRETURN_xLightSyncSignal
+    #define traceRETURN_xLightSyncSignal( xReturn )
+#endif
+
+#ifndef traceENTER_xLightSyncSignalFromISR
+    #define traceENTER_xLightSyncSignalFromISR( xSync, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xLightSyncSignalFromISR
+    #define traceRETURN_xLightSyncSignalFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_uxLightSyncGetCount
+    #define traceENTER_uxLightSyncGetCount( xSync )
+#endif
+
+#ifndef traceRETURN_uxLightSyncGetCount
+    #define traceRETURN_uxLightSyncGetCount( uxReturn )
+#endif
+
+#ifndef traceENTER_vLightSyncSetNotificationIndex
+    #define traceENTER_vLightSyncSetNotificationIndex( xSync, uxNotificationIndex )
+#endif
+
+#ifndef traceRETURN_vLightSyncSetNotificationIndex
+    #define traceRETURN_vLightSyncSetNotificationIndex()
+#endif
+
 #ifndef traceENTER_vListInitialise
     #define traceENTER_vListInitialise( pxList )
 #endif
@@ -2642,6 +3126,14 @@
     #define traceRETURN_vListInsert()
 #endif
 
+#ifndef traceENTER_vListInsertFrom
+    #define traceENTER_vListInsertFrom( pxList, pxStartListItem, pxNewListItem )
+#endif
+
+#ifndef traceRETURN_vListInsertFrom
+    #define traceRETURN_vListInsertFrom()
+#endif
+
 #ifndef traceENTER_uxListRemove
     #define traceENTER_uxListRemove( pxItemToRemove )
 #endif
@@ -2700,6 +3192,58 @@
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+/* Set configUSE_SCHEDULING_LATENCY_HISTOGRAM to 1 to record, for every task, a
+ * histogram of the time between the task being made ready and it being
+ * switched in, measured with the run time stats counter. */
+#ifndef configUSE_SCHEDULING_LATENCY_HISTOGRAM
+    #define configUSE_SCHEDULING_LATENCY_HISTOGRAM    0
+#endif
+
+/* Each power of two range of latencies is split into
+ * 2 ^ configSCHEDULING_LATENCY_SUB_BUCKET_BITS buckets, so a bucket is at
+ * most 1 / 2 ^ configSCHEDULING_LATENCY_SUB_BUCKET_BITS of its value wide. */
+#ifndef configSCHEDULING_LATENCY_SUB_BUCKET_BITS
+    #define configSCHEDULING_LATENCY_SUB_BUCKET_BITS    2
+#endif
+
+/* Latencies of 2 ^ configSCHEDULING_LATENCY_RANGE_BITS run time counter units
+ * or more are counted in the last bucket. */
+#ifndef configSCHEDULING_LATENCY_RANGE_BITS
+    #define configSCHEDULING_LATENCY_RANGE_BITS    32
+#endif
+
+#if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configUSE_SCHEDULING_LATENCY_HISTOGRAM requires configGENERATE_RUN_TIME_STATS to be 1, the latencies are measured with the run time stats counter.
+    #endif
+
+    /* At least one sub-bucket bit keeps the number of buckets even, so the
+     * histogram needs no padding whatever configRUN_TIME_COUNTER_TYPE is. */
+    #if ( ( configSCHEDULING_LATENCY_SUB_BUCKET_BITS < 1 ) || ( configSCHEDULING_LATENCY_SUB_BUCKET_BITS >= configSCHEDULING_LATENCY_RANGE_BITS ) )
+        #error configSCHEDULING_LATENCY_SUB_BUCKET_BITS must be at least 1 and less than configSCHEDULING_LATENCY_RANGE_BITS.
+    #endif
+#endif /* configUSE_SCHEDULING_LATENCY_HISTOGRAM */
+
+#define tskSCHEDULING_LATENCY_BUCKETS    ( ( configSCHEDULING_LATENCY_RANGE_BITS - configSCHEDULING_LATENCY_SUB_BUCKET_BITS + 1 ) << configSCHEDULING_LATENCY_SUB_BUCKET_BITS )
+
+/* Set configUSE_TASK_SNAPSHOT to 1 to include uxTaskGetSystemSnapshot(), which
+ * reports the same information as uxTaskGetSystemState() without suspending
+ * the scheduler while it walks the task lists. */
+#ifndef configUSE_TASK_SNAPSHOT
+    #define configUSE_TASK_SNAPSHOT    0
+#endif
+
+/* Number of tasks uxTaskGetSystemSnapshot() can report.  Tasks created while
+ * this many exist are left out, and counted by uxTaskGetSnapshotMissedTasks(),
+ * so size it for the most tasks the application can have at once. */
+#ifndef configTASK_SNAPSHOT_MAX_TASKS
+    #define configTASK_SNAPSHOT_MAX_TASKS    64
+#endif
+
+#if ( ( configUSE_TASK_SNAPSHOT == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+    #error configUSE_TASK_SNAPSHOT requires configUSE_TRACE_FACILITY to be 1.
+#endif
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -2744,6 +3288,21 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+/* Set configUSE_QUEUE_SET_READY_LIST to 1 to have a queue set hold the handle
+ * of each non-empty member once, rather than once per item.  Sending to a
+ * member that already holds items then leaves the set alone, and the set
+ * length only has to cover the number of members. */
+#ifndef configUSE_QUEUE_SET_READY_LIST
+    #define configUSE_QUEUE_SET_READY_LIST    0
+#endif
+
+/* Set configUSE_QUEUE_ZERO_COPY to 1 to include xQueueReserve(), xQueueCommit(),
+ * xQueueAcquire() and xQueueRelease(), which let items be written and read in
+ * place in the queue storage area instead of being copied. */
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -2800,6 +3359,17 @@
     #define configENABLE_HEAP_PROTECTOR    0
 #endif
 
+/* Set configUSE_HEAP_STATS to 1 to have the heap record the bytes currently
+ * allocated, their peak, a histogram of request sizes and per call site
+ * totals. Supported by heap_3.c and heap_6.c. */
+#ifndef configUSE_HEAP_STATS
+    #define configUSE_HEAP_STATS    0
+#endif
+
+#ifndef configHEAP_STATS_CALL_SITES
+    #define configHEAP_STATS_CALL_SITES    32
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
     #define configUSE_TASK_NOTIFICATIONS    1
 #endif
@@ -3202,6 +3772,10 @@ typedef struct xSTATIC_TCB
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
     #endif
+    #if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy23[ 5 ];
+        uint32_t ulDummy24[ tskSCHEDULING_LATENCY_BUCKETS ];
+    #endif
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         configTLS_BLOCK_TYPE xDummy17;
     #endif
@@ -3219,6 +3793,13 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+        UBaseType_t uxDummy25;
+    #endif
+    #if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+        void * pxDummy27;
+        UBaseType_t uxDummy28;
+    #endif
 } StaticTask_t;
 
 /*
@@ -3249,18 +3830,30 @@ typedef struct xSTATIC_QUEUE
     UBaseType_t uxDummy4[ 3 ];
     uint8_t ucDummy5[ 2 ];
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy12;
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy6;
     #endif
 
     #if ( configUSE_QUEUE_SETS == 1 )
         void * pvDummy7;
+
+        #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+            UBaseType_t uxDummy13;
+        #endif
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_EVENT_LIST_INDEX == 1 )
+        uint32_t ulDummy14[ 2 ][ ( configMAX_PRIORITIES + 31U ) / 32U ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -3281,7 +3874,13 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
     TickType_t xDummy1;
-    StaticList_t xDummy2;
+
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        StaticList_t xDummy2[ eventNUMBER_OF_EVENT_BITS ];
+        TickType_t xDummy5[ eventNUMBER_OF_EVENT_BITS ];
+    #else
+        StaticList_t xDummy2;
+    #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
@@ -3317,6 +3916,11 @@ typedef struct xSTATIC_TIMER
         UBaseType_t uxDummy7;
     #endif
     uint8_t ucDummy8;
+    #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+        uint8_t ucDummy9;
+        void * pvDummy10;
+        TickType_t xDummy11;
+    #endif
 } StaticTimer_t;
 
 /*
@@ -3350,6 +3954,43 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real SPSC queue structure is not accessible to the
+ * application.  The StaticSpscQueue_t structure below is provided so the memory
+ * for an SPSC queue can be statically allocated.  Its size and alignment
+ * requirements are guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_SPSC_QUEUE
+{
+    UBaseType_t uxDummy1[ 4 ];
+    void * pvDummy2[ 3 ];
+    UBaseType_t uxDummy3;
+    uint8_t ucDummy4;
+} StaticSpscQueue_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real lightweight semaphore and event structure is
+ * not accessible to the application.  The StaticLightSync_t structure below is
+ * provided so the memory for one can be statically allocated, including the
+ * semaphore it falls back to when more than one task waits on it.  Its size
+ * and alignment requirements are guaranteed to match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_LIGHT_SYNC
+{
+    UBaseType_t uxDummy1[ 2 ];
+    void * pvDummy2[ 2 ];
+    UBaseType_t uxDummy3[ 2 ];
+    uint8_t ucDummy4[ 2 ];
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        StaticQueue_t xDummy5;
+    #endif
+} StaticLightSync_t;
+typedef StaticLightSync_t StaticLightSemaphore_t;
+typedef StaticLightSync_t StaticLightEvent_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
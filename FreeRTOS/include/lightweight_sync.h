@@ -0,0 +1,401 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Lightweight semaphores and events are for the common case where a binary or
+ * counting semaphore, or a "this has happened" flag, only ever has one task
+ * waiting on it.  Giving and taking never touches a queue while no task is
+ * blocked, and the first task to block waits on a direct to task notification
+ * instead of a queue's event list, so giving to it is a single notify.
+ *
+ * Only when a second task blocks on the same object while the first is still
+ * waiting does the object fall back to the full path: those tasks block on an
+ * ordinary counting semaphore held by the object, which wakes them in priority
+ * order.  A give goes to the highest priority waiter, and the task waiting on
+ * a notification, being the oldest waiter, wins ties.
+ *
+ * A lightweight event is one-shot.  Once set it stays set, every task waiting
+ * for it is unblocked, and later waits return immediately.
+ *
+ * The task notification index used by the object (tskDEFAULT_INDEX_TO_NOTIFY
+ * unless changed with vLightSyncSetNotificationIndex()) must not be used for
+ * anything else by the tasks that wait on it: a task that waits as the lone
+ * waiter first clears the notification state of that index, which discards any
+ * notification pending on it, for example from xTaskNotifyGive().  Unlike a
+ * mutex there is no priority inheritance.
+ *
+ * A waiting task may be suspended or deleted.  If it is the task waiting on a
+ * notification the kernel removes it from the object, so gives go to the other
+ * waiters, and a resumed task simply waits again.  A task deleted while it is
+ * blocked on the fallback semaphore is still counted as a waiter, so the next
+ * give is parked on the fallback semaphore for whichever task blocks there
+ * next, and the object can then no longer be deleted.  Avoid deleting tasks
+ * that wait on a contended object.
+ */
+
+#ifndef LIGHTWEIGHT_SYNC_H
+#define LIGHTWEIGHT_SYNC_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include lightweight_sync.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The kind of object passed to xLightSyncGenericCreate(). */
+#define lightsyncTYPE_SEMAPHORE    ( ( uint8_t ) 0U )
+#define lightsyncTYPE_EVENT        ( ( uint8_t ) 1U )
+
+/**
+ * Type by which lightweight semaphores and events are referenced.  For example,
+ * a call to xLightSemaphoreCreateBinary() returns a LightSemaphoreHandle_t
+ * variable that can then be used as a parameter to xLightSemaphoreTake(),
+ * xLightSemaphoreGive(), etc.
+ */
+struct LightSyncDef_t;
+typedef struct LightSyncDef_t * LightSyncHandle_t;
+typedef LightSyncHandle_t       LightSemaphoreHandle_t;
+typedef LightSyncHandle_t       LightEventHandle_t;
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * LightSemaphoreHandle_t xLightSemaphoreCreateBinary( void );
+ * @endcode
+ *
+ * Creates a lightweight binary semaphore using dynamically allocated memory.
+ * As with xSemaphoreCreateBinary(), the semaphore is created empty, so it must
+ * be given before it can be taken.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION and configUSE_LIGHTWEIGHT_SYNC must both be
+ * set to 1 in FreeRTOSConfig.h for xLightSemaphoreCreateBinary() to be
+ * available.
+ *
+ * @return A handle to the created semaphore, or NULL if the memory required to
+ * hold it could not be allocated.
+ *
+ * \defgroup xLightSemaphoreCreateBinary xLightSemaphoreCreateBinary
+ * \ingroup LightSync
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    #define xLightSemaphoreCreateBinary()    xLightSyncGenericCreate( ( UBaseType_t ) 1, ( UBaseType_t ) 0, lightsyncTYPE_SEMAPHORE )
+#endif
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * LightSemaphoreHandle_t xLightSemaphoreCreateCounting( UBaseType_t uxMaxCount,
+ *                                                       UBaseType_t uxInitialCount );
+ * @endcode
+ *
+ * Creates a lightweight counting semaphore using dynamically allocated memory.
+ *
+ * @param uxMaxCount The maximum count value that can be reached.  Gives fail
+ * once the count is at this value and no task is waiting.
+ *
+ * @param uxInitialCount The count value assigned to the semaphore when it is
+ * created.
+ *
+ * @return A handle to the created semaphore, or NULL if the memory required to
+ * hold it could not be allocated.
+ *
+ * \defgroup xLightSemaphoreCreateCounting xLightSemaphoreCreateCounting
+ * \ingroup LightSync
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    #define xLightSemaphoreCreateCounting( uxMaxCount, uxInitialCount )    xLightSyncGenericCreate( ( uxMaxCount ), ( uxInitialCount ), lightsyncTYPE_SEMAPHORE )
+#endif
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * LightSemaphoreHandle_t xLightSemaphoreCreateBinaryStatic( StaticLightSemaphore_t *pxStaticSemaphore );
+ * LightSemaphoreHandle_t xLightSemaphoreCreateCountingStatic( UBaseType_t uxMaxCount,
+ *                                                             UBaseType_t uxInitialCount,
+ *                                                             StaticLightSemaphore_t *pxStaticSemaphore );
+ * @endcode
+ *
+ * As xLightSemaphoreCreateBinary() and xLightSemaphoreCreateCounting(), but
+ * the memory for the semaphore, including the semaphore it falls back to, is
+ * provided by the caller.
+ *
+ * configSUPPORT_STATIC_ALLOCATION and configUSE_LIGHTWEIGHT_SYNC must both be
+ * set to 1 in FreeRTOSConfig.h for these macros to be available.
+ *
+ * @param pxStaticSemaphore Must point to a variable of type
+ * StaticLightSemaphore_t, which will be used to hold the semaphore's state.
+ *
+ * @return If pxStaticSemaphore is not NULL then a handle to the created
+ * semaphore is returned, otherwise NULL is returned.
+ *
+ * \defgroup xLightSemaphoreCreateCountingStatic xLightSemaphoreCreateCountingStatic
+ * \ingroup LightSync
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #define xLightSemaphoreCreateBinaryStatic( pxStaticSemaphore )                                    xLightSyncGenericCreateStatic( ( UBaseType_t ) 1, ( UBaseType_t ) 0, lightsyncTYPE_SEMAPHORE, ( pxStaticSemaphore ) )
+    #define xLightSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxStaticSemaphore )    xLightSyncGenericCreateStatic( ( uxMaxCount ), ( uxInitialCount ), lightsyncTYPE_SEMAPHORE, ( pxStaticSemaphore ) )
+#endif
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * BaseType_t xLightSemaphoreTake( LightSemaphoreHandle_t xSemaphore, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes the semaphore, blocking for up to xTicksToWait ticks if the count is
+ * zero.  Must not be called from an interrupt.
+ *
+ * When several tasks are blocked, each give unblocks the highest priority one,
+ * and the longest waiting of those of equal priority.  A task that has been
+ * counted as a waiter but is still on its way to blocking when the give occurs
+ * can be passed over in favour of the lone task waiting on a notification.
+ *
+ * If the calling task becomes the lone waiter it waits on the semaphore's task
+ * notification index (tskDEFAULT_INDEX_TO_NOTIFY, so index 0, unless changed
+ * with vLightSyncSetNotificationIndex()).  Any notification already pending on
+ * that index of the calling task is cleared and lost, so that index must not
+ * be used for anything else.
+ *
+ * @return pdPASS if the semaphore was obtained, pdFAIL if xTicksToWait
+ * expired first.
+ *
+ * Example use:
+ * @code{c}
+ * void vHandlerTask( void * pvParameters )
+ * {
+ * LightSemaphoreHandle_t xDataReady = ( LightSemaphoreHandle_t ) pvParameters;
+ *
+ *  for( ;; )
+ *  {
+ *      // While this task is the only one waiting, the give from the
+ *      // interrupt is a single notification to this task.
+ *      if( xLightSemaphoreTake( xDataReady, pdMS_TO_TICKS( 100 ) ) == pdPASS )
+ *      {
+ *          vProcessData();
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xLightSemaphoreTake xLightSemaphoreTake
+ * \ingroup LightSync
+ */
+#define xLightSemaphoreTake( xSemaphore, xTicksToWait )    xLightSyncWait( ( xSemaphore ), ( xTicksToWait ) )
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * BaseType_t xLightSemaphoreGive( LightSemaphoreHandle_t xSemaphore );
+ * BaseType_t xLightSemaphoreGiveFromISR( LightSemaphoreHandle_t xSemaphore,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Gives the semaphore.  If a task is waiting the count is handed straight to
+ * it, otherwise the count is incremented.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if giving the semaphore
+ * unblocked a task that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the semaphore was given, pdFAIL if no task was waiting
+ * and the count was already at its maximum.
+ *
+ * \defgroup xLightSemaphoreGive xLightSemaphoreGive
+ * \ingroup LightSync
+ */
+#define xLightSemaphoreGive( xSemaphore )                                         xLightSyncSignal( ( xSemaphore ) )
+#define xLightSemaphoreGiveFromISR( xSemaphore, pxHigherPriorityTaskWoken )    xLightSyncSignalFromISR( ( xSemaphore ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * UBaseType_t uxLightSemaphoreGetCount( LightSemaphoreHandle_t xSemaphore );
+ * @endcode
+ *
+ * Returns the count of the semaphore.
+ *
+ * \defgroup uxLightSemaphoreGetCount uxLightSemaphoreGetCount
+ * \ingroup LightSync
+ */
+#define uxLightSemaphoreGetCount( xSemaphore )    uxLightSyncGetCount( ( xSemaphore ) )
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * void vLightSemaphoreDelete( LightSemaphoreHandle_t xSemaphore );
+ * @endcode
+ *
+ * Deletes a lightweight semaphore.  No task may be blocked on the semaphore
+ * when it is deleted.
+ *
+ * \defgroup vLightSemaphoreDelete vLightSemaphoreDelete
+ * \ingroup LightSync
+ */
+#define vLightSemaphoreDelete( xSemaphore )    vLightSyncDelete( ( xSemaphore ) )
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * LightEventHandle_t xLightEventCreate( void );
+ * LightEventHandle_t xLightEventCreateStatic( StaticLightEvent_t *pxStaticEvent );
+ * @endcode
+ *
+ * Creates a one-shot lightweight event, initially not set, using dynamically
+ * allocated memory or memory provided by the caller respectively.
+ *
+ * @return A handle to the created event, or NULL if the memory required to
+ * hold it could not be allocated, or pxStaticEvent is NULL.
+ *
+ * \defgroup xLightEventCreate xLightEventCreate
+ * \ingroup LightSync
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    #define xLightEventCreate()    xLightSyncGenericCreate( ( UBaseType_t ) 1, ( UBaseType_t ) 0, lightsyncTYPE_EVENT )
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #define xLightEventCreateStatic( pxStaticEvent )    xLightSyncGenericCreateStatic( ( UBaseType_t ) 1, ( UBaseType_t ) 0, lightsyncTYPE_EVENT, ( pxStaticEvent ) )
+#endif
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * BaseType_t xLightEventWait( LightEventHandle_t xEvent, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Blocks for up to xTicksToWait ticks for the event to be set.  Returns
+ * immediately if it is already set.  Must not be called from an interrupt.
+ *
+ * @return pdPASS if the event is set, pdFAIL if xTicksToWait expired first.
+ *
+ * \defgroup xLightEventWait xLightEventWait
+ * \ingroup LightSync
+ */
+#define xLightEventWait( xEvent, xTicksToWait )    xLightSyncWait( ( xEvent ), ( xTicksToWait ) )
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * BaseType_t xLightEventSet( LightEventHandle_t xEvent );
+ * BaseType_t xLightEventSetFromISR( LightEventHandle_t xEvent,
+ *                                   BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Sets the event and unblocks every task waiting for it.
+ *
+ * @return pdPASS if this call set the event, pdFAIL if it was already set.
+ *
+ * \defgroup xLightEventSet xLightEventSet
+ * \ingroup LightSync
+ */
+#define xLightEventSet( xEvent )                                         xLightSyncSignal( ( xEvent ) )
+#define xLightEventSetFromISR( xEvent, pxHigherPriorityTaskWoken )    xLightSyncSignalFromISR( ( xEvent ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * BaseType_t xLightEventIsSet( LightEventHandle_t xEvent );
+ * void vLightEventDelete( LightEventHandle_t xEvent );
+ * @endcode
+ *
+ * Query whether the event has been set, and delete an event no task is
+ * waiting on.
+ *
+ * \defgroup xLightEventIsSet xLightEventIsSet
+ * \ingroup LightSync
+ */
+#define xLightEventIsSet( xEvent )     ( ( uxLightSyncGetCount( ( xEvent ) ) != ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE )
+#define vLightEventDelete( xEvent )    vLightSyncDelete( ( xEvent ) )
+
+/*
+ * The functions the macros above map to.  xLightSyncWait() takes a semaphore
+ * or waits for an event, xLightSyncSignal() gives a semaphore or sets an event.
+ * They are not intended to be called directly; use the macros instead.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    LightSyncHandle_t xLightSyncGenericCreate( UBaseType_t uxMaxCount,
+                                               UBaseType_t uxInitialCount,
+                                               uint8_t ucSyncType ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    LightSyncHandle_t xLightSyncGenericCreateStatic( UBaseType_t uxMaxCount,
+                                                     UBaseType_t uxInitialCount,
+                                                     uint8_t ucSyncType,
+                                                     StaticLightSync_t * const pxStaticSync ) PRIVILEGED_FUNCTION;
+#endif
+
+void vLightSyncDelete( LightSyncHandle_t xSync ) PRIVILEGED_FUNCTION;
+
+BaseType_t xLightSyncWait( LightSyncHandle_t xSync,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+BaseType_t xLightSyncSignal( LightSyncHandle_t xSync ) PRIVILEGED_FUNCTION;
+
+BaseType_t xLightSyncSignalFromISR( LightSyncHandle_t xSync,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+UBaseType_t uxLightSyncGetCount( LightSyncHandle_t xSync ) PRIVILEGED_FUNCTION;
+
+/**
+ * lightweight_sync.h
+ *
+ * @code{c}
+ * void vLightSyncSetNotificationIndex( LightSyncHandle_t xSync, UBaseType_t uxNotificationIndex );
+ * @endcode
+ *
+ * Set the task notification index a lone waiting task waits on.  Must be
+ * called before the semaphore or event is used.
+ *
+ * \defgroup vLightSyncSetNotificationIndex vLightSyncSetNotificationIndex
+ * \ingroup LightSync
+ */
+void vLightSyncSetNotificationIndex( LightSyncHandle_t xSync,
+                                     UBaseType_t uxNotificationIndex ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( LIGHTWEIGHT_SYNC_H ) */
@@ -465,6 +465,27 @@ void vListInitialiseItem( ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
 void vListInsert( List_t * const pxList,
                   ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
 
+/*
+ * As vListInsert(), but the search for the insertion position starts at
+ * pxStartListItem instead of the head of the list.  pxStartListItem must be
+ * either the list end marker or an item within pxList whose item value is
+ * not greater than the item value of pxNewListItem, otherwise the list will
+ * no longer be sorted.  The item ends up in the same position vListInsert()
+ * would have placed it in.
+ *
+ * @param pxList The list into which the item is to be inserted.
+ *
+ * @param pxStartListItem The item from which to start searching.
+ *
+ * @param pxNewListItem The item that is to be placed in the list.
+ *
+ * \page vListInsertFrom vListInsertFrom
+ * \ingroup LinkedList
+ */
+void vListInsertFrom( List_t * const pxList,
+                      ListItem_t * pxStartListItem,
+                      ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
 /*
  * Insert a list item into a list.  The item will be inserted in a position
  * such that it will be the last item within the list returned by multiple
@@ -85,6 +85,12 @@
  */
 typedef StreamBufferHandle_t MessageBufferHandle_t;
 
+/**
+ * Type used to describe the fragments passed to xMessageBufferSendFragments()
+ * and the buffers passed to uxMessageBufferReceiveMultiple().
+ */
+typedef StreamBufferVector_t MessageBufferVector_t;
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -587,6 +593,112 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) \
     xStreamBufferReceive( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendFragments( MessageBufferHandle_t xMessageBuffer,
+ *                                     const MessageBufferVector_t * pxFragments,
+ *                                     UBaseType_t uxFragmentCount,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends one message made up of uxFragmentCount separate regions, such as a
+ * header and a payload, without first copying them into a temporary buffer.
+ * The length of the message is the sum of the fragment lengths.  Otherwise
+ * behaves exactly like xMessageBufferSend(): the message is written in full or
+ * not at all, and the same single writer restrictions apply.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xMessageBufferSendFragments() to be available.
+ *
+ * @param xMessageBuffer The handle of the message buffer to which a message is
+ * being sent.
+ *
+ * @param pxFragments An array of uxFragmentCount regions that are written, in
+ * order, as the body of the message.
+ *
+ * @param uxFragmentCount The number of entries in pxFragments.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for enough space to become available in
+ * the message buffer, as described for xMessageBufferSend().
+ *
+ * @return The number of bytes written to the message buffer.  If the call to
+ * xMessageBufferSendFragments() times out before there was enough space to
+ * write the message into the message buffer then zero is returned.
+ *
+ * \defgroup xMessageBufferSendFragments xMessageBufferSendFragments
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendFragments( xMessageBuffer, pxFragments, uxFragmentCount, xTicksToWait ) \
+    xStreamBufferSendFragments( ( xMessageBuffer ), ( pxFragments ), ( uxFragmentCount ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * UBaseType_t uxMessageBufferReceiveMultiple( MessageBufferHandle_t xMessageBuffer,
+ *                                             MessageBufferVector_t * pxMessages,
+ *                                             UBaseType_t uxMaxMessages,
+ *                                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives up to uxMaxMessages messages in one call.  Waits for at least one
+ * message to be available, then copies out every complete message already in
+ * the message buffer until pxMessages is exhausted or the next message does not
+ * fit in the next entry of pxMessages.  A task waiting to write to the message
+ * buffer is notified once, after all the messages have been removed.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * uxMessageBufferReceiveMultiple() to be available.
+ *
+ * @param xMessageBuffer The handle of the message buffer from which messages
+ * are being received.
+ *
+ * @param pxMessages An array of uxMaxMessages receive buffers.  On entry each
+ * xLength is the size of the buffer pointed to by pvData.  On return the
+ * xLength of each filled entry holds the length of the message it received.
+ *
+ * @param uxMaxMessages The number of entries in pxMessages.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a message, should the message buffer be empty.
+ *
+ * @return The number of messages received, which fill the first entries of
+ * pxMessages.
+ *
+ * Example use:
+ * @code{c}
+ * void vALogTask( MessageBufferHandle_t xMessageBuffer )
+ * {
+ * static uint8_t ucLines[ 8 ][ 64 ];
+ * MessageBufferVector_t xLines[ 8 ];
+ * UBaseType_t uxLine, uxCount;
+ *
+ *  for( ;; )
+ *  {
+ *      for( uxLine = 0; uxLine < 8; uxLine++ )
+ *      {
+ *          xLines[ uxLine ].pvData = ucLines[ uxLine ];
+ *          xLines[ uxLine ].xLength = sizeof( ucLines[ uxLine ] );
+ *      }
+ *
+ *      uxCount = uxMessageBufferReceiveMultiple( xMessageBuffer, xLines, 8, portMAX_DELAY );
+ *
+ *      for( uxLine = 0; uxLine < uxCount; uxLine++ )
+ *      {
+ *          // Process xLines[ uxLine ].xLength bytes of ucLines[ uxLine ].
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxMessageBufferReceiveMultiple uxMessageBufferReceiveMultiple
+ * \ingroup MessageBufferManagement
+ */
+#define uxMessageBufferReceiveMultiple( xMessageBuffer, pxMessages, uxMaxMessages, xTicksToWait ) \
+    uxStreamBufferReceiveMessages( ( xMessageBuffer ), ( pxMessages ), ( uxMaxMessages ), ( xTicksToWait ) )
+
 
 /**
  * message_buffer.h
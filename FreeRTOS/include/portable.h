@@ -152,6 +152,19 @@ typedef struct HeapRegion
     size_t xSizeInBytes;
 } HeapRegion_t;
 
+#ifndef portHEAP_STATS_HISTOGRAM_BUCKETS
+    #define portHEAP_STATS_HISTOGRAM_BUCKETS    24
+#endif
+
+/* Identifies the caller of pvPortMalloc() when configUSE_HEAP_STATS is 1. */
+#ifndef portHEAP_STATS_CALL_SITE
+    #if defined( __GNUC__ )
+        #define portHEAP_STATS_CALL_SITE()    __builtin_return_address( 0 )
+    #else
+        #define portHEAP_STATS_CALL_SITE()    NULL
+    #endif
+#endif
+
 /* Used to pass information about the heap out of vPortGetHeapStats(). */
 typedef struct xHeapStats
 {
@@ -162,8 +175,27 @@ typedef struct xHeapStats
     size_t xMinimumEverFreeBytesRemaining;  /* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
     size_t xNumberOfSuccessfulAllocations;  /* The number of calls to pvPortMalloc() that have returned a valid memory block. */
     size_t xNumberOfSuccessfulFrees;        /* The number of calls to vPortFree() that has successfully freed a block of memory. */
+    #if ( configUSE_HEAP_STATS == 1 )
+        size_t xCurrentAllocatedBytes;                                     /* The sum of the sizes requested by all blocks that are currently allocated. */
+        size_t xPeakAllocatedBytes;                                        /* The largest value xCurrentAllocatedBytes has had since the system booted. */
+        size_t xAllocationSizeHistogram[ portHEAP_STATS_HISTOGRAM_BUCKETS ]; /* Number of allocations by requested size. Bucket n counts sizes from 2^n to 2^(n+1)-1 bytes, the last bucket counts all larger sizes. */
+    #endif
 } HeapStats_t;
 
+#if ( configUSE_HEAP_STATS == 1 )
+
+/* Used to pass per call site allocation totals out of
+ * uxPortGetHeapCallSiteStats(). */
+    typedef struct xHeapCallSiteStats
+    {
+        void * pvCallSite;           /* Return address of the pvPortMalloc() call, NULL for the entry that collects call sites that did not fit in the table. */
+        size_t xNumberOfAllocations; /* The number of successful allocations made from this call site. */
+        size_t xNumberOfFrees;       /* The number of those allocations that have been freed. */
+        size_t xCurrentBytes;        /* The bytes requested by this call site that are still allocated. */
+        size_t xTotalBytes;          /* The bytes requested by this call site since the system booted. */
+    } HeapCallSiteStats_t;
+#endif
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -183,6 +215,29 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+#if ( configUSE_HEAP_STATS == 1 )
+
+/*
+ * Fills pxCallSiteStats with up to uxArraySize call sites of pvPortMalloc(),
+ * ordered by the total number of bytes they have requested, largest first.
+ * Returns the number of entries written.
+ */
+    UBaseType_t uxPortGetHeapCallSiteStats( HeapCallSiteStats_t * const pxCallSiteStats,
+                                            const UBaseType_t uxArraySize );
+
+/*
+ * Used by the heap implementations to record allocations and frees. The
+ * value returned by uxPortHeapStatsRecordMalloc() identifies the call site and
+ * must be passed back to vPortHeapStatsRecordFree() when the block is freed.
+ */
+    UBaseType_t uxPortHeapStatsRecordMalloc( size_t xWantedSize,
+                                             void * pvCallSite ) PRIVILEGED_FUNCTION;
+    void vPortHeapStatsRecordFree( size_t xWantedSize,
+                                   UBaseType_t uxCallSite ) PRIVILEGED_FUNCTION;
+    void vPortHeapStatsFill( HeapStats_t * pxHeapStats ) PRIVILEGED_FUNCTION;
+    void vPortHeapStatsResetState( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -914,6 +914,238 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultiple(
+ *                                  QueueHandle_t xQueue,
+ *                                  const void *pvItemsToQueue,
+ *                                  UBaseType_t uxItemCount,
+ *                                  TickType_t xTicksToWait
+ *                               );
+ * @endcode
+ *
+ * Post several items to the back of a queue.  Each critical section copies as
+ * many of the items as the queue has space for and unblocks the tasks waiting
+ * to receive them, so a burst of items costs far less than the same number of
+ * calls to xQueueSend().  The items are queued in order, but items sent by
+ * other tasks can be interleaved with them if the queue fills.
+ *
+ * The items must not be sent to a queue created with an item size of 0.  This
+ * function must not be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to uxItemCount items stored one after the
+ * other, each the size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time, in total, the task should
+ * block waiting for space to become available on the queue.
+ *
+ * @return The number of items posted, which is less than uxItemCount if the
+ * block time expired before all the items could be posted.
+ *
+ * Example usage:
+ * @code{c}
+ * void vProducer( QueueHandle_t xQueue )
+ * {
+ * uint32_t ulEvents[ 64 ];
+ * UBaseType_t uxCount;
+ *
+ *  uxCount = prvCollectEvents( ulEvents );
+ *
+ *  if( xQueueSendMultiple( xQueue, ulEvents, uxCount, pdMS_TO_TICKS( 10 ) ) != uxCount )
+ *  {
+ *      // Some events were dropped.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                const void * const pvItemsToQueue,
+                                UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultiple(
+ *                                     QueueHandle_t xQueue,
+ *                                     void *pvBuffer,
+ *                                     UBaseType_t uxMaxItems,
+ *                                     TickType_t xTicksToWait
+ *                                  );
+ * @endcode
+ *
+ * Receive several items from a queue in one critical section.  The call blocks
+ * until at least one item is available, then removes as many items as are in
+ * the queue, up to uxMaxItems, and unblocks the tasks waiting for the space
+ * that has been freed.
+ *
+ * This function must not be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty at the time of the call.
+ *
+ * @return The number of items received, which is 0 if the block time expired
+ * with the queue still empty.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   UBaseType_t uxMaxItems,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReserve(
+ *                            QueueHandle_t xQueue,
+ *                            void **ppvSlot,
+ *                            TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Reserve the slot at the back of a queue so an item can be written directly
+ * into the queue storage area instead of being copied in by xQueueSend().  The
+ * item is not visible to receivers until xQueueCommit() is called.
+ *
+ * Only one slot of a queue can be reserved at a time.  While a slot is
+ * reserved it counts against the space available in the queue, and other
+ * items cannot be sent to the back of the queue.  The queue must not have been
+ * created with an item size of 0.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle to the queue in which the slot is reserved.
+ *
+ * @param ppvSlot Set to the start of the reserved slot, which is uxItemSize
+ * bytes long.  Set to NULL if no slot could be reserved.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for a slot to become available.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vProducer( QueueHandle_t xQueue )
+ * {
+ * struct AMessage *pxMessage;
+ *
+ *  if( xQueueReserve( xQueue, ( void ** ) &pxMessage, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      pxMessage->ucMessageID = 0x10;
+ *      xQueueCommit( xQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueReserve xQueueReserve
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** ppvSlot,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommit( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Post the item written into the slot returned by xQueueReserve() to the back
+ * of the queue, unblocking a task waiting to receive from the queue if any.
+ *
+ * @param xQueue The handle to the queue in which a slot was reserved.
+ *
+ * @return pdPASS if the item was posted, or pdFAIL if no slot was reserved.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueAcquire(
+ *                            QueueHandle_t xQueue,
+ *                            void **ppvItem,
+ *                            TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Remove the item at the front of a queue, leaving it in the queue storage
+ * area so it can be read in place instead of being copied out by
+ * xQueueReceive().  The slot the item occupies is not reused until
+ * xQueueRelease() is called.
+ *
+ * Only one item of a queue can be acquired at a time.  While an item is
+ * acquired its slot counts against the space available in the queue, and no
+ * other item can be received from, or sent to the front of, the queue.
+ * xQueuePeek() does not wait for the release: it returns the item behind the
+ * acquired one, if there is one.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle to the queue from which the item is acquired.
+ *
+ * @param ppvItem Set to the start of the acquired item.  Set to NULL if no
+ * item could be acquired.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to become available.
+ *
+ * @return pdPASS if an item was acquired, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueueAcquire xQueueAcquire
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueAcquire( QueueHandle_t xQueue,
+                              void ** ppvItem,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueRelease( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Return the slot of the item obtained from xQueueAcquire() to the queue,
+ * unblocking a task waiting to send to the queue if any.
+ *
+ * @param xQueue The handle to the queue from which an item was acquired.
+ *
+ * @return pdPASS if the slot was returned, or pdFAIL if no item was acquired.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -1687,6 +1919,11 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  *  + If a queue set is to hold a counting semaphore that has a maximum count of
  *    5, and a counting semaphore that has a maximum count of 3, then
  *    uxEventQueueLength should be set to (5 + 3), or 8.
+ * If configUSE_QUEUE_SET_READY_LIST is set to 1 in FreeRTOSConfig.h the set
+ * holds the handle of each non-empty member once instead, so
+ * uxEventQueueLength is the maximum number of members, whatever their length.
+ * xQueueSelectFromSet() then returns the non-empty members in turn, each once
+ * per item, rather than in the order the items arrived.
  *
  * @return If the queue set is created successfully then a handle to the created
  * queue set is returned.  Otherwise NULL is returned.
@@ -1775,7 +2012,8 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * @return If the queue or semaphore was successfully added to the queue set
  * then pdPASS is returned.  If the queue could not be successfully added to the
  * queue set because it is already a member of a different queue set then pdFAIL
- * is returned.
+ * is returned.  With configUSE_QUEUE_SET_READY_LIST set to 1, pdFAIL is also
+ * returned if the set already has as many members as its length.
  */
 #if ( configUSE_QUEUE_SETS == 1 )
     BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
@@ -1873,6 +2111,18 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
 UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Sets *puxPriority to the priority of the highest priority task blocked
+ * receiving from xQueue and returns pdTRUE, or returns pdFALSE if no task is.
+ * Must be called from within a critical section.  Used by lightweight_sync.c.
+ * The result can be stale after a waiting task's priority changes, see the
+ * comment in the function.
+ */
+#if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+    BaseType_t xQueueGetHighestReceiverPriority( QueueHandle_t xQueue,
+                                                 UBaseType_t * const puxPriority ) PRIVILEGED_FUNCTION;
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
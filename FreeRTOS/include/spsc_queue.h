@@ -0,0 +1,329 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * SPSC queues hold a fixed number of fixed size items, like a queue, but with
+ * the restriction of stream buffers: there must be only one task or interrupt
+ * that writes to the queue (the producer), and only one task or interrupt that
+ * reads from it (the consumer).  In exchange, sending and receiving an item
+ * never enters a critical section or suspends the scheduler unless the other
+ * side is blocked on the queue, or the caller has to block itself.  Each side
+ * only ever writes its own index into the ring, and the indexes are ordered
+ * against the item data with portMEMORY_BARRIER().
+ *
+ * A task that blocks on an SPSC queue waits on a task notification, so the
+ * notification index used by the queue (tskDEFAULT_INDEX_TO_NOTIFY unless
+ * changed with vSpscQueueSetNotificationIndex()) must not be used for anything
+ * else by the producer and consumer tasks.
+ *
+ * ***NOTE***:  SPSC queues are for single core builds only.  Most ports,
+ * including the POSIX port, define portMEMORY_BARRIER() as a compiler barrier,
+ * which orders the accesses against a task switch or interrupt on the same core
+ * but not against another core.  Building spsc_queue.c with
+ * configNUMBER_OF_CORES greater than 1 is an error.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_queue.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which SPSC queues are referenced.  For example, a call to
+ * xSpscQueueCreate() returns an SpscQueueHandle_t variable that can then be
+ * used as a parameter to xSpscQueueSend(), xSpscQueueReceive(), etc.
+ */
+struct SpscQueueDef_t;
+typedef struct SpscQueueDef_t * SpscQueueHandle_t;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SpscQueueHandle_t xSpscQueueCreate( UBaseType_t uxQueueLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new single producer, single consumer queue using dynamically
+ * allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION and configUSE_SPSC_QUEUES must both be set
+ * to 1 in FreeRTOSConfig.h for xSpscQueueCreate() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold at any
+ * one time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Items are copied into
+ * and out of the queue, as they are for a queue created by xQueueCreate().
+ *
+ * @return If the queue is created successfully then a handle to the created
+ * queue is returned.  If the memory required to hold the queue could not be
+ * allocated then NULL is returned.
+ *
+ * \defgroup xSpscQueueCreate xSpscQueueCreate
+ * \ingroup SpscQueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscQueueHandle_t xSpscQueueCreate( UBaseType_t uxQueueLength,
+                                        UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SpscQueueHandle_t xSpscQueueCreateStatic( UBaseType_t uxQueueLength,
+ *                                           UBaseType_t uxItemSize,
+ *                                           uint8_t *pucQueueStorage,
+ *                                           StaticSpscQueue_t *pxStaticQueue );
+ * @endcode
+ *
+ * As xSpscQueueCreate(), but the memory for the queue is provided by the
+ * caller.
+ *
+ * configSUPPORT_STATIC_ALLOCATION and configUSE_SPSC_QUEUES must both be set
+ * to 1 in FreeRTOSConfig.h for xSpscQueueCreateStatic() to be available.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array that is at least
+ * ( uxQueueLength * uxItemSize ) bytes long.
+ *
+ * @param pxStaticQueue Must point to a variable of type StaticSpscQueue_t,
+ * which will be used to hold the queue's data structure.
+ *
+ * @return If neither pucQueueStorage nor pxStaticQueue are NULL then a handle
+ * to the created queue is returned, otherwise NULL is returned.
+ *
+ * \defgroup xSpscQueueCreateStatic xSpscQueueCreateStatic
+ * \ingroup SpscQueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SpscQueueHandle_t xSpscQueueCreateStatic( UBaseType_t uxQueueLength,
+                                              UBaseType_t uxItemSize,
+                                              uint8_t * const pucQueueStorage,
+                                              StaticSpscQueue_t * const pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * void vSpscQueueDelete( SpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Deletes a queue that was previously created using xSpscQueueCreate() or
+ * xSpscQueueCreateStatic().  No task may be blocked on the queue when it is
+ * deleted.
+ *
+ * \defgroup vSpscQueueDelete vSpscQueueDelete
+ * \ingroup SpscQueueManagement
+ */
+void vSpscQueueDelete( SpscQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueSend( SpscQueueHandle_t xQueue,
+ *                            const void *pvItemToQueue,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item to the back of the queue.  Must only be called by the single
+ * producer of the queue.  Use xSpscQueueSendFromISR() if the producer is an
+ * interrupt.
+ *
+ * @param xQueue The handle of the queue to which the item is sent.
+ *
+ * @param pvItemToQueue A pointer to the item to copy into the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for space to become available should the queue be
+ * full.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * Example use:
+ * @code{c}
+ * void vProducer( SpscQueueHandle_t xQueue )
+ * {
+ * uint32_t ulSample;
+ *
+ *  for( ;; )
+ *  {
+ *      ulSample = ulReadSensor();
+ *
+ *      // Only takes a critical section if the queue is full, or the consumer
+ *      // is blocked waiting for the sample.
+ *      xSpscQueueSend( xQueue, &ulSample, portMAX_DELAY );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSpscQueueSend xSpscQueueSend
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueSend( SpscQueueHandle_t xQueue,
+                           const void * pvItemToQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueSendFromISR( SpscQueueHandle_t xQueue,
+ *                                   const void *pvItemToQueue,
+ *                                   BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscQueueSend() that never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a consumer task that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xSpscQueueSendFromISR xSpscQueueSendFromISR
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueSendFromISR( SpscQueueHandle_t xQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueReceive( SpscQueueHandle_t xQueue,
+ *                               void *pvBuffer,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the item at the front of the queue into pvBuffer and removes it from
+ * the queue.  Must only be called by the single consumer of the queue.  Use
+ * xSpscQueueReceiveFromISR() if the consumer is an interrupt.
+ *
+ * @param xQueue The handle of the queue from which the item is received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for an item should the queue be empty.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xSpscQueueReceive xSpscQueueReceive
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueReceive( SpscQueueHandle_t xQueue,
+                              void * const pvBuffer,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueReceiveFromISR( SpscQueueHandle_t xQueue,
+ *                                      void *pvBuffer,
+ *                                      BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscQueueReceive() that never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item
+ * unblocked a producer task that has a priority above the interrupted task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xSpscQueueReceiveFromISR xSpscQueueReceiveFromISR
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueReceiveFromISR( SpscQueueHandle_t xQueue,
+                                     void * const pvBuffer,
+                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * UBaseType_t uxSpscQueueMessagesWaiting( SpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Returns the number of items in the queue.  The value is only a snapshot if
+ * called by a task other than the producer or consumer.
+ *
+ * \defgroup uxSpscQueueMessagesWaiting uxSpscQueueMessagesWaiting
+ * \ingroup SpscQueueManagement
+ */
+UBaseType_t uxSpscQueueMessagesWaiting( SpscQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * UBaseType_t uxSpscQueueSpacesAvailable( SpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Returns the number of free spaces in the queue.
+ *
+ * \defgroup uxSpscQueueSpacesAvailable uxSpscQueueSpacesAvailable
+ * \ingroup SpscQueueManagement
+ */
+UBaseType_t uxSpscQueueSpacesAvailable( SpscQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * void vSpscQueueSetNotificationIndex( SpscQueueHandle_t xQueue, UBaseType_t uxNotificationIndex );
+ * @endcode
+ *
+ * Set the task notification index a blocked producer or consumer waits on.
+ * Must be called before the queue is used.
+ *
+ * \defgroup vSpscQueueSetNotificationIndex vSpscQueueSetNotificationIndex
+ * \ingroup SpscQueueManagement
+ */
+void vSpscQueueSetNotificationIndex( SpscQueueHandle_t xQueue,
+                                     UBaseType_t uxNotificationIndex ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_QUEUE_H ) */
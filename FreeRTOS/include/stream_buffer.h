@@ -85,6 +85,18 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * Describes one region of caller memory passed to xStreamBufferSendFragments()
+ * or uxStreamBufferReceiveMessages().  When sending, pvData points to xLength
+ * bytes to be written.  When receiving, pvData points to a buffer xLength bytes
+ * long, and xLength is updated to the length of the message copied into it.
+ */
+typedef struct xSTREAM_BUFFER_VECTOR
+{
+    void * pvData;
+    size_t xLength;
+} StreamBufferVector_t;
+
 /**
  * stream_buffer.h
  *
@@ -879,6 +891,270 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
                                     size_t xBufferLengthBytes,
                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendFragments( StreamBufferHandle_t xStreamBuffer,
+ *                                    const StreamBufferVector_t * pxFragments,
+ *                                    UBaseType_t uxFragmentCount,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Gather version of xStreamBufferSend().  The uxFragmentCount regions described
+ * by pxFragments are written to the buffer back to back, without first being
+ * copied into a temporary buffer.  Typically used to send a header and a
+ * payload that are held in different places.
+ *
+ * If xStreamBuffer is a message buffer then the fragments form a single
+ * message, the length of which is the sum of the fragment lengths.  The
+ * message is written in full or not at all, exactly as if it had been passed
+ * to xStreamBufferSend() in one piece.  If xStreamBuffer is a stream buffer
+ * then as many bytes as fit are written, starting from the first fragment.
+ *
+ * The reader is notified once, after every fragment has been written.
+ *
+ * The same single writer restrictions that apply to xStreamBufferSend() apply
+ * to this function.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer to which
+ * data is being sent.
+ *
+ * @param pxFragments An array of uxFragmentCount regions to write, in order.
+ * Fragments with a zero xLength are permitted.
+ *
+ * @param uxFragmentCount The number of entries in pxFragments.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for enough space to become available,
+ * as described for xStreamBufferSend().
+ *
+ * @return The number of data bytes written, not counting the bytes used to
+ * hold a message length.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( MessageBufferHandle_t xMessageBuffer,
+ *                  LogHeader_t * pxHeader,
+ *                  const char * pcText )
+ * {
+ * StreamBufferVector_t xFragments[ 2 ];
+ *
+ *  xFragments[ 0 ].pvData = pxHeader;
+ *  xFragments[ 0 ].xLength = sizeof( LogHeader_t );
+ *  xFragments[ 1 ].pvData = ( void * ) pcText;
+ *  xFragments[ 1 ].xLength = strlen( pcText );
+ *
+ *  xStreamBufferSendFragments( xMessageBuffer, xFragments, 2, 0 );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendFragments xStreamBufferSendFragments
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFragments( StreamBufferHandle_t xStreamBuffer,
+                                   const StreamBufferVector_t * pxFragments,
+                                   UBaseType_t uxFragmentCount,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * UBaseType_t uxStreamBufferReceiveMessages( StreamBufferHandle_t xStreamBuffer,
+ *                                            StreamBufferVector_t * pxMessages,
+ *                                            UBaseType_t uxMaxMessages,
+ *                                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives up to uxMaxMessages messages from a message buffer in one call.
+ * Waits, for at most xTicksToWait ticks, for at least one message to be
+ * available, then copies out every complete message already in the buffer,
+ * stopping early when pxMessages is exhausted or when the next message does
+ * not fit in the next entry of pxMessages.  A message that does not fit is left
+ * in the buffer.
+ *
+ * The space freed by all the messages is released together and a task waiting
+ * to write is notified once, rather than once per message.
+ *
+ * Can only be used with message buffers.  The same single reader restrictions
+ * that apply to xStreamBufferReceive() apply to this function.
+ *
+ * @param xStreamBuffer The handle of the message buffer from which messages
+ * are being received.
+ *
+ * @param pxMessages An array of uxMaxMessages buffers.  On entry each xLength
+ * is the size of the buffer pointed to by pvData.  On return xLength of each of
+ * the first N entries holds the length of the message copied into it, where N
+ * is the returned value.
+ *
+ * @param uxMaxMessages The number of entries in pxMessages.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for a message, should the buffer be
+ * empty.
+ *
+ * @return The number of messages received.
+ *
+ * \defgroup uxStreamBufferReceiveMessages uxStreamBufferReceiveMessages
+ * \ingroup StreamBufferManagement
+ */
+UBaseType_t uxStreamBufferReceiveMessages( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferVector_t * pxMessages,
+                                           UBaseType_t uxMaxMessages,
+                                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferGetReadSpan( StreamBufferHandle_t xStreamBuffer,
+ *                                  StreamBufferVector_t pxSpans[ 2 ],
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Gives the reader direct access to the bytes held in a stream buffer, so they
+ * can be processed in place instead of being copied out by
+ * xStreamBufferReceive().  Because the buffer is a ring the bytes may be split
+ * in two: pxSpans[ 0 ] describes the bytes from the read position up to the end
+ * of the buffer's storage area, and pxSpans[ 1 ] the bytes that continue from
+ * the start of the storage area.  pxSpans[ 1 ].xLength is zero if the data does
+ * not wrap.
+ *
+ * The bytes remain in the stream buffer, and the spans remain valid, until
+ * they are released by calling xStreamBufferConsume().  The writer may add more
+ * data in the meantime, which is reported by the next call.
+ *
+ * Cannot be used with message buffers.  Only the reader may call this
+ * function, and it must not be called from an interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param pxSpans An array of two spans that is set to describe the readable
+ * bytes.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state for data to become available, as described for
+ * xStreamBufferReceive().
+ *
+ * @return The total number of readable bytes, which is the sum of the two
+ * span lengths.
+ *
+ * Example use:
+ * @code{c}
+ * void vAParserTask( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * StreamBufferVector_t xSpans[ 2 ];
+ * size_t xUsed;
+ *
+ *  for( ;; )
+ *  {
+ *      ( void ) xStreamBufferGetReadSpan( xStreamBuffer, xSpans, portMAX_DELAY );
+ *
+ *      // Parse in place, returning the number of bytes fully processed.
+ *      xUsed = xParse( xSpans[ 0 ].pvData, xSpans[ 0 ].xLength );
+ *
+ *      if( xUsed == xSpans[ 0 ].xLength )
+ *      {
+ *          xUsed += xParse( xSpans[ 1 ].pvData, xSpans[ 1 ].xLength );
+ *      }
+ *
+ *      xStreamBufferConsume( xStreamBuffer, xUsed );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferGetReadSpan xStreamBufferGetReadSpan
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetReadSpan( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferVector_t pxSpans[ 2 ],
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+ *                              size_t xBytesConsumed );
+ * @endcode
+ *
+ * Removes the first xBytesConsumed bytes from a stream buffer after they have
+ * been read in place through the spans returned by xStreamBufferGetReadSpan(),
+ * and notifies a task waiting for space.  xBytesConsumed must not exceed the
+ * number of bytes that call reported.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param xBytesConsumed The number of bytes to remove.
+ *
+ * @return xBytesConsumed.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xBytesConsumed ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferGetWriteSpan( StreamBufferHandle_t xStreamBuffer,
+ *                                   StreamBufferVector_t pxSpans[ 2 ],
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * The writer side equivalent of xStreamBufferGetReadSpan().  Describes the
+ * free space of a stream buffer as at most two spans, so data can be produced
+ * directly into the buffer instead of being copied in by xStreamBufferSend().
+ * Nothing written into the spans is visible to the reader until it is
+ * published by calling xStreamBufferCommit().
+ *
+ * Cannot be used with message buffers.  Only the writer may call this
+ * function, and it must not be called from an interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written.
+ *
+ * @param pxSpans An array of two spans that is set to describe the free space.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state for at least one byte of space to become
+ * available.
+ *
+ * @return The total number of bytes that can be written, which is the sum of
+ * the two span lengths.
+ *
+ * \defgroup xStreamBufferGetWriteSpan xStreamBufferGetWriteSpan
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetWriteSpan( StreamBufferHandle_t xStreamBuffer,
+                                  StreamBufferVector_t pxSpans[ 2 ],
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+ *                             size_t xBytesWritten );
+ * @endcode
+ *
+ * Publishes the first xBytesWritten bytes of the spans returned by
+ * xStreamBufferGetWriteSpan() to the reader, and notifies a task waiting for
+ * data if the trigger level has been reached.  xBytesWritten must not exceed
+ * the number of bytes that call reported.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written.
+ *
+ * @param xBytesWritten The number of bytes to publish.
+ *
+ * @return xBytesWritten.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                            size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -131,6 +131,19 @@ typedef struct xTIME_OUT
     TickType_t xTimeOnEntering;
 } TimeOut_t;
 
+/*
+ * Used internally only.  Bit n is set while an event list may hold waiters of
+ * priority n, see configUSE_EVENT_LIST_INDEX.
+ */
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+    #define taskEVENT_LIST_INDEX_WORDS    ( ( configMAX_PRIORITIES + 31U ) / 32U )
+
+    typedef struct xEVENT_LIST_INDEX
+    {
+        uint32_t ulOccupiedPriorities[ taskEVENT_LIST_INDEX_WORDS ];
+    } EventListIndex_t;
+#endif
+
 /*
  * Defines the memory ranges allocated to the task when an MPU is used.
  */
@@ -180,6 +193,19 @@ typedef struct xTASK_STATUS
     #endif
 } TaskStatus_t;
 
+/* Used with vTaskGetSchedulingLatency() to return the histogram of the time
+ * between a task being made ready and it being switched in.  Times are in run
+ * time stats counter units, see ulTaskGetSchedulingLatencyBucketValue() for the
+ * range of each bucket. */
+typedef struct xTASK_LATENCY_HISTOGRAM
+{
+    configRUN_TIME_COUNTER_TYPE ulSamples;                /* Number of times the task was switched in after being made ready. */
+    configRUN_TIME_COUNTER_TYPE ulMin;                    /* Shortest latency, only valid if ulSamples is not 0. */
+    configRUN_TIME_COUNTER_TYPE ulMax;                    /* Longest latency. */
+    configRUN_TIME_COUNTER_TYPE ulTotal;                  /* Sum of all latencies, for the mean. */
+    uint32_t ulBuckets[ tskSCHEDULING_LATENCY_BUCKETS ]; /* Number of latencies that fell in each bucket. */
+} TaskLatencyHistogram_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -2183,6 +2209,76 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetSystemSnapshot( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );
+ * @endcode
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 in FreeRTOSConfig.h for
+ * uxTaskGetSystemSnapshot() to be available.
+ *
+ * Fills the same TaskStatus_t structures as uxTaskGetSystemState(), but
+ * without suspending the scheduler while every task list is walked, so it is
+ * suitable for polling task state periodically on a running system.  The kernel
+ * keeps a registry of all tasks (sized by configTASK_SNAPSHOT_MAX_TASKS) and
+ * each task is read from it inside its own short critical section.
+ *
+ * The differences from uxTaskGetSystemState() are:
+ *
+ * - Each entry is consistent, but entries are read one after the other, so
+ *   tasks may change state, or be created or deleted, while the snapshot is
+ *   taken.
+ *
+ * - If pxTaskStatusArray is too small the entries that fit are filled in,
+ *   rather than none.
+ *
+ * - usStackHighWaterMark is set to 0, as scanning the stack is not a constant
+ *   time operation.  Use uxTaskGetStackHighWaterMark() where it is needed.
+ *
+ * - Tasks created while configTASK_SNAPSHOT_MAX_TASKS tasks already exist are
+ *   not reported, even after other tasks are deleted.  Check
+ *   uxTaskGetSnapshotMissedTasks() to know whether a snapshot is complete.
+ *
+ * @param pxTaskStatusArray An array of TaskStatus_t structures to fill in.
+ *
+ * @param uxArraySize The number of entries in pxTaskStatusArray.
+ *
+ * @param pulTotalRunTime If configGENERATE_RUN_TIME_STATS is 1 then
+ * *pulTotalRunTime is set to the run time stats counter at the end of the
+ * snapshot, otherwise it is set to 0.  Can be NULL.
+ *
+ * @return The number of TaskStatus_t structures filled in.
+ *
+ * \defgroup uxTaskGetSystemSnapshot uxTaskGetSystemSnapshot
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+    UBaseType_t uxTaskGetSystemSnapshot( TaskStatus_t * const pxTaskStatusArray,
+                                         const UBaseType_t uxArraySize,
+                                         configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetSnapshotMissedTasks( void );
+ * @endcode
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 in FreeRTOSConfig.h for
+ * uxTaskGetSnapshotMissedTasks() to be available.
+ *
+ * @return The number of tasks that currently exist but are left out of
+ * uxTaskGetSystemSnapshot() because the registry was full when they were
+ * created.  If it is not 0, increase configTASK_SNAPSHOT_MAX_TASKS.
+ *
+ * \defgroup uxTaskGetSnapshotMissedTasks uxTaskGetSnapshotMissedTasks
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+    UBaseType_t uxTaskGetSnapshotMissedTasks( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2514,6 +2610,54 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetSchedulingLatency( TaskHandle_t xTask, TaskLatencyHistogram_t * pxHistogram );
+ * void vTaskResetSchedulingLatency( TaskHandle_t xTask );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetSchedulingLatencyPercentile( const TaskLatencyHistogram_t * pxHistogram, UBaseType_t uxPercentile );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetSchedulingLatencyBucketValue( UBaseType_t uxBucket );
+ * @endcode
+ *
+ * configUSE_SCHEDULING_LATENCY_HISTOGRAM and configGENERATE_RUN_TIME_STATS must
+ * be defined as 1 for these functions to be available.
+ *
+ * The kernel timestamps a task with the run time stats counter when it is
+ * unblocked, resumed or created, and adds the time until it is next switched
+ * in to a histogram held in its TCB.  Tasks that are preempted or yield are
+ * not counted when they run again, so the histogram measures wake up latency
+ * only.
+ *
+ * Bucket widths grow with the latency: each power of two range is split into
+ * 2 ^ configSCHEDULING_LATENCY_SUB_BUCKET_BITS buckets, so with the default of
+ * 2 a latency is known to within 25%, and latencies below
+ * 2 ^ ( configSCHEDULING_LATENCY_SUB_BUCKET_BITS + 1 ) counts exactly.
+ *
+ * vTaskGetSchedulingLatency() copies the histogram of xTask (or of the calling
+ * task if xTask is NULL) into pxHistogram, and vTaskResetSchedulingLatency()
+ * clears it.
+ *
+ * ulTaskGetSchedulingLatencyPercentile() returns the latency below which
+ * uxPercentile percent (0 to 100) of the samples in pxHistogram fall.  It
+ * reports the top of the bucket holding that sample, capped at the largest
+ * latency seen, so it never understates the latency.  It returns 0 for an
+ * empty histogram.
+ *
+ * ulTaskGetSchedulingLatencyBucketValue() returns the smallest latency counted
+ * in bucket uxBucket, which must be less than tskSCHEDULING_LATENCY_BUCKETS.
+ *
+ * \defgroup vTaskGetSchedulingLatency vTaskGetSchedulingLatency
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+    void vTaskGetSchedulingLatency( TaskHandle_t xTask,
+                                    TaskLatencyHistogram_t * pxHistogram ) PRIVILEGED_FUNCTION;
+    void vTaskResetSchedulingLatency( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetSchedulingLatencyPercentile( const TaskLatencyHistogram_t * pxHistogram,
+                                                                      UBaseType_t uxPercentile ) PRIVILEGED_FUNCTION;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetSchedulingLatencyBucketValue( UBaseType_t uxBucket ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3518,7 +3662,8 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  *
  * The 'ordered' version uses the existing event list item value (which is the
  * owning task's priority) to insert the list item into the event list in task
- * priority order.
+ * priority order.  The 'indexed' version does the same, but finds the position
+ * through pxIndex, which must only ever be used with pxEventList.
  *
  * @param pxEventList The list containing tasks that are blocked waiting
  * for the event to occur.
@@ -3533,6 +3678,11 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskPlaceOnEventList( List_t * const pxEventList,
                             const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+    void vTaskPlaceOnIndexedEventList( List_t * const pxEventList,
+                                       EventListIndex_t * const pxIndex,
+                                       const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
                                      const TickType_t xItemValue,
                                      const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
@@ -3600,6 +3750,24 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  */
 TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
+ * THE LIGHTWEIGHT SEMAPHORE AND EVENT MODULE.
+ *
+ * vTaskSetLightSyncWaiter() records that the calling task's handle is held in
+ * *pxWaiterRecord while it waits on notification index uxIndexToWaitOn, or
+ * clears the record when pxWaiterRecord is NULL.  If the task is deleted or
+ * suspended while *pxWaiterRecord still holds its handle, the kernel sets
+ * *pxWaiterRecord to NULL, clears the task's record and marks a notification
+ * as received on uxIndexToWaitOn.  pxTaskGetLightSyncWaiter() returns the
+ * calling task's record.  Both must be called from a critical section.
+ */
+#if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+    void vTaskSetLightSyncWaiter( TaskHandle_t volatile * pxWaiterRecord,
+                                  UBaseType_t uxIndexToWaitOn ) PRIVILEGED_FUNCTION;
+    TaskHandle_t volatile * pxTaskGetLightSyncWaiter( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Return the handle of the calling task.
  */
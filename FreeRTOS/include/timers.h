@@ -1111,6 +1111,39 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
     xTimerGenericCommand( ( xTimer ), tmrCOMMAND_RESET_FROM_ISR, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
 
 
+/**
+ * BaseType_t xTimerResetMultiple( TimerHandle_t const * pxTimers,
+ *                                 const UBaseType_t uxTimerCount );
+ *
+ * Resets (or starts) every timer in the pxTimers array without blocking and
+ * without using space in the timer command queue.  Each timer behaves as if
+ * xTimerReset() had been called for it at the time xTimerResetMultiple() was
+ * called.
+ *
+ * The resets are recorded on a list that the timer service task works through
+ * after it has emptied the timer command queue.  A timer is only ever on that
+ * list once, so resetting the same timer again before the timer service task
+ * has run only updates the time the reset is relative to.  Any command sent
+ * for a timer through the timer command queue cancels a reset of that timer
+ * still pending from xTimerResetMultiple().
+ *
+ * configUSE_TIMER_COMMAND_BATCHING must be set to 1 in FreeRTOSConfig.h for
+ * xTimerResetMultiple() to be available.  It must not be called from an
+ * interrupt service routine.
+ *
+ * @param pxTimers An array of handles of the timers being reset.
+ *
+ * @param uxTimerCount The number of handles in pxTimers.
+ *
+ * @return pdFAIL will be returned if the timer service infrastructure has not
+ * been created yet, otherwise pdPASS will be returned.
+ */
+#if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+    BaseType_t xTimerResetMultiple( TimerHandle_t const * pxTimers,
+                                    const UBaseType_t uxTimerCount ) PRIVILEGED_FUNCTION;
+    #define xTimerStartMultiple( pxTimers, uxTimerCount )    xTimerResetMultiple( ( pxTimers ), ( uxTimerCount ) )
+#endif
+
 /**
  * BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend,
  *                                          void *pvParameter1,
@@ -54,15 +54,69 @@
     #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
 
+#if ( configUSE_HEAP_STATS == 1 )
+
+/* When statistics are enabled each block is prefixed with a header that
+ * remembers the requested size and call site, as free() cannot report
+ * either. The header is padded so the memory handed out keeps the port's
+ * byte alignment. */
+    typedef struct A_BLOCK_HEADER
+    {
+        size_t xWantedSize;
+        UBaseType_t uxCallSite;
+    } BlockHeader_t;
+
+    #define heapHEADER_SIZE    ( ( sizeof( BlockHeader_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+    PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+    PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+    PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = configTOTAL_HEAP_SIZE;
+#endif /* configUSE_HEAP_STATS */
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
 {
     void * pvReturn;
 
+    #if ( configUSE_HEAP_STATS == 1 )
+        void * pvCallSite = portHEAP_STATS_CALL_SITE();
+        BlockHeader_t * pxHeader;
+        size_t xFreeBytes;
+    #endif
+
     vTaskSuspendAll();
     {
-        pvReturn = malloc( xWantedSize );
+        #if ( configUSE_HEAP_STATS == 1 )
+        {
+            pvReturn = NULL;
+
+            if( xWantedSize <= ( SIZE_MAX - heapHEADER_SIZE ) )
+            {
+                pxHeader = malloc( heapHEADER_SIZE + xWantedSize );
+
+                if( pxHeader != NULL )
+                {
+                    pxHeader->xWantedSize = xWantedSize;
+                    pxHeader->uxCallSite = uxPortHeapStatsRecordMalloc( xWantedSize, pvCallSite );
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxHeader ) + heapHEADER_SIZE );
+                    xNumberOfSuccessfulAllocations++;
+
+                    xFreeBytes = xPortGetFreeHeapSize();
+
+                    if( xFreeBytes < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytes;
+                    }
+                }
+            }
+        }
+        #else /* configUSE_HEAP_STATS */
+        {
+            pvReturn = malloc( xWantedSize );
+        }
+        #endif /* configUSE_HEAP_STATS */
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -86,14 +140,76 @@ void vPortFree( void * pv )
     {
         vTaskSuspendAll();
         {
-            free( pv );
-            traceFREE( pv, 0 );
+            #if ( configUSE_HEAP_STATS == 1 )
+            {
+                BlockHeader_t * pxHeader = ( BlockHeader_t * ) ( ( ( uint8_t * ) pv ) - heapHEADER_SIZE );
+
+                vPortHeapStatsRecordFree( pxHeader->xWantedSize, pxHeader->uxCallSite );
+                xNumberOfSuccessfulFrees++;
+                traceFREE( pv, pxHeader->xWantedSize );
+                free( pxHeader );
+            }
+            #else
+            {
+                free( pv );
+                traceFREE( pv, 0 );
+            }
+            #endif
         }
         ( void ) xTaskResumeAll();
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_STATS == 1 )
+
+/*
+ * malloc() has no fixed size, so the free heap size reported here is the
+ * part of configTOTAL_HEAP_SIZE not taken by the blocks currently allocated.
+ * Use it as a budget check, the C library can still allocate beyond it.
+ */
+    size_t xPortGetFreeHeapSize( void )
+    {
+        HeapStats_t xHeapStats;
+
+        vPortHeapStatsFill( &xHeapStats );
+
+        if( xHeapStats.xCurrentAllocatedBytes >= ( size_t ) configTOTAL_HEAP_SIZE )
+        {
+            return 0U;
+        }
+
+        return ( size_t ) configTOTAL_HEAP_SIZE - xHeapStats.xCurrentAllocatedBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPortGetMinimumEverFreeHeapSize( void )
+    {
+        return xMinimumEverFreeBytesRemaining;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+    {
+        vTaskSuspendAll();
+        {
+            vPortHeapStatsFill( pxHeapStats );
+
+            /* The free blocks belong to the C library and are not visible. */
+            pxHeapStats->xAvailableHeapSpaceInBytes = xPortGetFreeHeapSize();
+            pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0U;
+            pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0U;
+            pxHeapStats->xNumberOfFreeBlocks = 0U;
+            pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+            pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+            pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_STATS */
+
 /*
  * Reset the state in this file. This state is normally initialized at start up.
  * This function must be called by the application before restarting the
@@ -101,6 +217,13 @@ void vPortFree( void * pv )
  */
 void vPortHeapResetState( void )
 {
-    /* No state needs to be re-initialised in heap_3. */
+    #if ( configUSE_HEAP_STATS == 1 )
+    {
+        xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+        xNumberOfSuccessfulFrees = ( size_t ) 0U;
+        xMinimumEverFreeBytesRemaining = configTOTAL_HEAP_SIZE;
+        vPortHeapStatsResetState();
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
@@ -0,0 +1,420 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * A fixed capacity pool allocator with O(1) pvPortMalloc() and vPortFree().
+ *
+ * Every request is rounded up to the smallest of a fixed set of size classes
+ * that can hold it. Each size class keeps a singly linked list of free blocks, so
+ * allocating pops the head of a list and freeing pushes onto it. When a list
+ * is empty a new block is carved from the end of the unused part of the heap
+ * array. Blocks are never split or merged and never change size class, so
+ * the heap cannot fragment: a freed TCB or task stack is reused as-is by the
+ * next task that is created.
+ *
+ * The size classes are the powers of two from 16 bytes to 64 KiB, plus the
+ * exact sizes of the objects the kernel allocates most often - the TCB, a
+ * semaphore or mutex, an event group and a configMINIMAL_STACK_SIZE stack -
+ * taken from sizeof() at compile time, so none of those is rounded up to the
+ * next power of two. Requests larger than the largest size class fail.
+ *
+ * The free lists are protected by a short critical section instead of
+ * suspending the scheduler, as no operation ever walks a list.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c and heap_4.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* The largest power of two size class, and so the largest request that can
+ * be met. */
+#define heapMAX_BLOCK_SIZE            ( ( size_t ) 65536U )
+
+/* The header in front of each block, and the size of each class, are padded
+ * so the memory handed out keeps the port's byte alignment. */
+#define heapBYTE_ALIGNMENT_MASK       ( ( size_t ) portBYTE_ALIGNMENT_MASK )
+#define heapALIGN_UP( xSize )         ( ( ( size_t ) ( xSize ) + heapBYTE_ALIGNMENT_MASK ) & ~heapBYTE_ALIGNMENT_MASK )
+#define heapHEADER_SIZE               heapALIGN_UP( sizeof( BlockHeader_t ) )
+
+#define heapNUM_SIZE_CLASSES          ( sizeof( xSizeClassBytes ) / sizeof( xSizeClassBytes[ 0 ] ) )
+
+/* The top bit of the size class stored in a block header is set while the
+ * block is allocated, which catches double frees and frees of foreign
+ * pointers. */
+#define heapBLOCK_ALLOCATED_BITMASK   ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBITS_PER_BYTE             ( ( size_t ) 8 )
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Sits in front of every block, allocated or free. */
+typedef struct A_BLOCK_HEADER
+{
+    size_t xSizeClass;       /**< Index into xFreeBlockLists, plus heapBLOCK_ALLOCATED_BITMASK while allocated. */
+    #if ( configUSE_HEAP_STATS == 1 )
+        size_t xWantedSize;      /**< The size passed to pvPortMalloc(). */
+        UBaseType_t uxCallSite;  /**< Returned by uxPortHeapStatsRecordMalloc(). */
+    #endif
+} BlockHeader_t;
+
+/* Overlays the user area of a block while the block is free. */
+typedef struct A_FREE_BLOCK
+{
+    struct A_FREE_BLOCK * pxNextFreeBlock;
+} FreeBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the smallest size class that can hold xWantedSize
+ * bytes. xWantedSize must not exceed heapMAX_BLOCK_SIZE.
+ */
+static size_t prvSizeClassFor( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size in bytes of the blocks in each size class, not in size order. A
+ * class that happens to equal a power of two is never chosen, the power of two
+ * listed first is. */
+static const size_t xSizeClassBytes[] =
+{
+    16U, 32U, 64U, 128U, 256U, 512U, 1024U, 2048U, 4096U, 8192U, 16384U, 32768U, heapMAX_BLOCK_SIZE,
+    heapALIGN_UP( sizeof( StaticTask_t ) ),
+    heapALIGN_UP( sizeof( StaticQueue_t ) ),
+    heapALIGN_UP( sizeof( StaticEventGroup_t ) ),
+    heapALIGN_UP( ( size_t ) configMINIMAL_STACK_SIZE * sizeof( StackType_t ) )
+};
+
+PRIVILEGED_DATA static FreeBlock_t * pxFreeBlockLists[ heapNUM_SIZE_CLASSES ] = { NULL };
+
+/* Number of free blocks in each size class. */
+PRIVILEGED_DATA static size_t xFreeBlockCounts[ heapNUM_SIZE_CLASSES ] = { 0U };
+
+/* Offset into ucHeap of the first byte that has never been handed out. */
+PRIVILEGED_DATA static size_t xNextFreeByte = ( size_t ) 0U;
+
+/* Keeps track of the amount of memory available in free lists and in the
+ * unused part of the heap array, and the low water mark of that amount. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+PRIVILEGED_DATA static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static size_t prvSizeClassFor( size_t xWantedSize )
+{
+    size_t xSizeClass;
+    size_t xBestSizeClass = heapNUM_SIZE_CLASSES;
+
+    /* The number of classes is fixed, so this is still constant time. */
+    for( xSizeClass = 0U; xSizeClass < heapNUM_SIZE_CLASSES; xSizeClass++ )
+    {
+        if( ( xSizeClassBytes[ xSizeClass ] >= xWantedSize ) &&
+            ( ( xBestSizeClass == heapNUM_SIZE_CLASSES ) ||
+              ( xSizeClassBytes[ xSizeClass ] < xSizeClassBytes[ xBestSizeClass ] ) ) )
+        {
+            xBestSizeClass = xSizeClass;
+        }
+    }
+
+    return xBestSizeClass;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    void * pvReturn = NULL;
+    BlockHeader_t * pxHeader = NULL;
+    FreeBlock_t * pxBlock;
+    size_t xSizeClass;
+    size_t xBlockSize;
+
+    #if ( configUSE_HEAP_STATS == 1 )
+        void * pvCallSite = portHEAP_STATS_CALL_SITE();
+    #endif
+
+    if( ( xWantedSize > ( size_t ) 0 ) && ( xWantedSize <= heapMAX_BLOCK_SIZE ) )
+    {
+        xSizeClass = prvSizeClassFor( xWantedSize );
+        xBlockSize = heapHEADER_SIZE + xSizeClassBytes[ xSizeClass ];
+
+        taskENTER_CRITICAL();
+        {
+            if( xHeapHasBeenInitialised == pdFALSE )
+            {
+                xFreeBytesRemaining = configTOTAL_HEAP_SIZE;
+                xMinimumEverFreeBytesRemaining = configTOTAL_HEAP_SIZE;
+                xHeapHasBeenInitialised = pdTRUE;
+            }
+
+            pxBlock = pxFreeBlockLists[ xSizeClass ];
+
+            if( pxBlock != NULL )
+            {
+                /* Reuse a block of the same size class. */
+                pxFreeBlockLists[ xSizeClass ] = pxBlock->pxNextFreeBlock;
+                xFreeBlockCounts[ xSizeClass ]--;
+                pxHeader = ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) - heapHEADER_SIZE );
+            }
+            else if( xBlockSize <= ( configTOTAL_HEAP_SIZE - xNextFreeByte ) )
+            {
+                /* Carve a new block from the unused end of the heap. */
+                pxHeader = ( BlockHeader_t * ) &( ucHeap[ xNextFreeByte ] );
+                xNextFreeByte += xBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxHeader != NULL )
+            {
+                pxHeader->xSizeClass = xSizeClass | heapBLOCK_ALLOCATED_BITMASK;
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxHeader ) + heapHEADER_SIZE );
+
+                #if ( configUSE_HEAP_STATS == 1 )
+                {
+                    pxHeader->xWantedSize = xWantedSize;
+                    pxHeader->uxCallSite = uxPortHeapStatsRecordMalloc( xWantedSize, pvCallSite );
+                }
+                #endif
+
+                xFreeBytesRemaining -= xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+
+                xNumberOfSuccessfulAllocations++;
+            }
+
+            traceMALLOC( pvReturn, xWantedSize );
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+    }
+    #endif
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & heapBYTE_ALIGNMENT_MASK ) == 0 );
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    BlockHeader_t * pxHeader;
+    FreeBlock_t * pxBlock;
+    size_t xSizeClass;
+
+    if( pv != NULL )
+    {
+        pxHeader = ( BlockHeader_t * ) ( ( ( uint8_t * ) pv ) - heapHEADER_SIZE );
+
+        /* The block must come from this heap and be allocated. */
+        configASSERT( ( ( uint8_t * ) pxHeader >= ucHeap ) && ( ( uint8_t * ) pxHeader < &( ucHeap[ configTOTAL_HEAP_SIZE ] ) ) );
+        configASSERT( ( pxHeader->xSizeClass & heapBLOCK_ALLOCATED_BITMASK ) != 0 );
+
+        xSizeClass = pxHeader->xSizeClass & ~heapBLOCK_ALLOCATED_BITMASK;
+        configASSERT( xSizeClass < heapNUM_SIZE_CLASSES );
+
+        taskENTER_CRITICAL();
+        {
+            pxHeader->xSizeClass = xSizeClass;
+
+            #if ( configUSE_HEAP_STATS == 1 )
+            {
+                vPortHeapStatsRecordFree( pxHeader->xWantedSize, pxHeader->uxCallSite );
+            }
+            #endif
+
+            pxBlock = ( FreeBlock_t * ) pv;
+            pxBlock->pxNextFreeBlock = pxFreeBlockLists[ xSizeClass ];
+            pxFreeBlockLists[ xSizeClass ] = pxBlock;
+            xFreeBlockCounts[ xSizeClass ]++;
+
+            xFreeBytesRemaining += heapHEADER_SIZE + xSizeClassBytes[ xSizeClass ];
+            xNumberOfSuccessfulFrees++;
+
+            traceFREE( pv, xSizeClassBytes[ xSizeClass ] );
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xHeapHasBeenInitialised != pdFALSE ? xFreeBytesRemaining : ( size_t ) configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xHeapHasBeenInitialised != pdFALSE ? xMinimumEverFreeBytesRemaining : ( size_t ) configTOTAL_HEAP_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+void xPortResetHeapMinimumEverFreeHeapSize( void )
+{
+    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    size_t xSizeClass;
+    size_t xBlockSize;
+    size_t xUnusedBytes;
+    size_t xMaxSize = 0;
+    size_t xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    size_t xBlocks = 0;
+
+    taskENTER_CRITICAL();
+    {
+        for( xSizeClass = 0; xSizeClass < heapNUM_SIZE_CLASSES; xSizeClass++ )
+        {
+            if( xFreeBlockCounts[ xSizeClass ] > 0U )
+            {
+                xBlockSize = xSizeClassBytes[ xSizeClass ];
+                xBlocks += xFreeBlockCounts[ xSizeClass ];
+
+                if( xBlockSize > xMaxSize )
+                {
+                    xMaxSize = xBlockSize;
+                }
+
+                if( xBlockSize < xMinSize )
+                {
+                    xMinSize = xBlockSize;
+                }
+            }
+        }
+
+        /* The unused end of the heap array counts as one more free block. */
+        xUnusedBytes = configTOTAL_HEAP_SIZE - xNextFreeByte;
+
+        if( xUnusedBytes > heapHEADER_SIZE )
+        {
+            xBlocks++;
+            xUnusedBytes -= heapHEADER_SIZE;
+
+            if( xUnusedBytes > xMaxSize )
+            {
+                xMaxSize = configMIN( xUnusedBytes, heapMAX_BLOCK_SIZE );
+            }
+
+            if( xUnusedBytes < xMinSize )
+            {
+                xMinSize = xUnusedBytes;
+            }
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = xPortGetFreeHeapSize();
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = ( xBlocks > 0U ) ? xMinSize : 0U;
+        pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xPortGetMinimumEverFreeHeapSize();
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+
+        #if ( configUSE_HEAP_STATS == 1 )
+        {
+            vPortHeapStatsFill( pxHeapStats );
+        }
+        #endif
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState( void )
+{
+    memset( pxFreeBlockLists, 0, sizeof( pxFreeBlockLists ) );
+    memset( xFreeBlockCounts, 0, sizeof( xFreeBlockCounts ) );
+
+    xNextFreeByte = ( size_t ) 0U;
+    xFreeBytesRemaining = ( size_t ) 0U;
+    xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+    xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+    xNumberOfSuccessfulFrees = ( size_t ) 0U;
+    xHeapHasBeenInitialised = pdFALSE;
+
+    #if ( configUSE_HEAP_STATS == 1 )
+    {
+        vPortHeapStatsResetState();
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,206 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Allocation statistics shared by the heap implementations that support
+ * configUSE_HEAP_STATS (heap_3.c and heap_6.c).
+ *
+ * The heap calls uxPortHeapStatsRecordMalloc() and vPortHeapStatsRecordFree()
+ * with its own lock held, so nothing in this file needs further protection
+ * apart from the functions that read the statistics out.
+ *
+ * Call sites are the return addresses of pvPortMalloc() calls. They are kept
+ * in a small open addressed hash table. Once the table is full, new call
+ * sites are accounted to a last entry with a NULL call site.
+ */
+
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_HEAP_STATS == 1 )
+
+/* The entry that collects call sites that did not fit in the table. */
+    #define heapstatsOVERFLOW_CALL_SITE    ( ( UBaseType_t ) configHEAP_STATS_CALL_SITES )
+
+    PRIVILEGED_DATA static HeapCallSiteStats_t xCallSites[ configHEAP_STATS_CALL_SITES + 1 ];
+    PRIVILEGED_DATA static size_t xCurrentAllocatedBytes = 0U;
+    PRIVILEGED_DATA static size_t xPeakAllocatedBytes = 0U;
+    PRIVILEGED_DATA static size_t xSizeHistogram[ portHEAP_STATS_HISTOGRAM_BUCKETS ] = { 0U };
+
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvFindCallSite( void * pvCallSite )
+    {
+        UBaseType_t uxIndex = ( UBaseType_t ) ( ( ( portPOINTER_SIZE_TYPE ) pvCallSite ) >> 2 ) % configHEAP_STATS_CALL_SITES;
+        UBaseType_t uxProbes;
+
+        for( uxProbes = 0; uxProbes < configHEAP_STATS_CALL_SITES; uxProbes++ )
+        {
+            if( xCallSites[ uxIndex ].pvCallSite == pvCallSite )
+            {
+                return uxIndex;
+            }
+
+            if( xCallSites[ uxIndex ].pvCallSite == NULL )
+            {
+                xCallSites[ uxIndex ].pvCallSite = pvCallSite;
+                return uxIndex;
+            }
+
+            uxIndex = ( uxIndex + 1U ) % configHEAP_STATS_CALL_SITES;
+        }
+
+        return heapstatsOVERFLOW_CALL_SITE;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvSizeHistogramBucket( size_t xSize )
+    {
+        UBaseType_t uxBucket = 0U;
+
+        while( ( xSize > ( size_t ) 1U ) && ( uxBucket < ( portHEAP_STATS_HISTOGRAM_BUCKETS - 1U ) ) )
+        {
+            xSize >>= 1;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortHeapStatsRecordMalloc( size_t xWantedSize,
+                                             void * pvCallSite )
+    {
+        UBaseType_t uxCallSite = prvFindCallSite( pvCallSite );
+
+        xCallSites[ uxCallSite ].xNumberOfAllocations++;
+        xCallSites[ uxCallSite ].xCurrentBytes += xWantedSize;
+        xCallSites[ uxCallSite ].xTotalBytes += xWantedSize;
+
+        xCurrentAllocatedBytes += xWantedSize;
+
+        if( xCurrentAllocatedBytes > xPeakAllocatedBytes )
+        {
+            xPeakAllocatedBytes = xCurrentAllocatedBytes;
+        }
+
+        xSizeHistogram[ prvSizeHistogramBucket( xWantedSize ) ]++;
+
+        return uxCallSite;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortHeapStatsRecordFree( size_t xWantedSize,
+                                   UBaseType_t uxCallSite )
+    {
+        configASSERT( uxCallSite <= heapstatsOVERFLOW_CALL_SITE );
+        configASSERT( xCallSites[ uxCallSite ].xCurrentBytes >= xWantedSize );
+
+        xCallSites[ uxCallSite ].xNumberOfFrees++;
+        xCallSites[ uxCallSite ].xCurrentBytes -= xWantedSize;
+        xCurrentAllocatedBytes -= xWantedSize;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortHeapStatsFill( HeapStats_t * pxHeapStats )
+    {
+        pxHeapStats->xCurrentAllocatedBytes = xCurrentAllocatedBytes;
+        pxHeapStats->xPeakAllocatedBytes = xPeakAllocatedBytes;
+        memcpy( pxHeapStats->xAllocationSizeHistogram, xSizeHistogram, sizeof( xSizeHistogram ) );
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetHeapCallSiteStats( HeapCallSiteStats_t * const pxCallSiteStats,
+                                            const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxCount = 0U;
+        UBaseType_t uxIndex;
+        UBaseType_t uxPosition;
+
+        configASSERT( ( pxCallSiteStats != NULL ) || ( uxArraySize == 0U ) );
+
+        vTaskSuspendAll();
+        {
+            /* Insertion sort into the caller's array, largest total first,
+             * keeping only the top uxArraySize entries. */
+            for( uxIndex = 0; uxIndex <= heapstatsOVERFLOW_CALL_SITE; uxIndex++ )
+            {
+                if( xCallSites[ uxIndex ].xNumberOfAllocations == 0U )
+                {
+                    continue;
+                }
+
+                uxPosition = uxCount;
+
+                while( ( uxPosition > 0U ) && ( pxCallSiteStats[ uxPosition - 1U ].xTotalBytes < xCallSites[ uxIndex ].xTotalBytes ) )
+                {
+                    if( uxPosition < uxArraySize )
+                    {
+                        pxCallSiteStats[ uxPosition ] = pxCallSiteStats[ uxPosition - 1U ];
+                    }
+
+                    uxPosition--;
+                }
+
+                if( uxPosition < uxArraySize )
+                {
+                    pxCallSiteStats[ uxPosition ] = xCallSites[ uxIndex ];
+
+                    if( uxCount < uxArraySize )
+                    {
+                        uxCount++;
+                    }
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortHeapStatsResetState( void )
+    {
+        memset( xCallSites, 0, sizeof( xCallSites ) );
+        memset( xSizeHistogram, 0, sizeof( xSizeHistogram ) );
+        xCurrentAllocatedBytes = 0U;
+        xPeakAllocatedBytes = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_STATS */
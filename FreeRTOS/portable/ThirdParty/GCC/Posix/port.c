@@ -39,6 +39,13 @@
 *
 * The timer interrupt uses SIGALRM and care is taken to ensure that
 * the signal handler runs only on the thread for the current task.
+* The tick thread paces itself against absolute deadlines, either with
+* clock_nanosleep() or, when configPOSIX_TICK_USE_TIMERFD is set, with a
+* timerfd. It publishes how many tick periods have elapsed since the
+* scheduler started and the handler processes every tick it has not
+* processed yet, so ticks that are late or merged into a single signal
+* are caught up rather than lost. A tick is not signalled again to a
+* thread that has not yet handled the previous one.
 *
 * Use of part of the standard C library requires care as some
 * functions can take pthread mutexes internally which can result in
@@ -65,6 +72,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <sys/times.h>
 #include <time.h>
@@ -77,6 +85,50 @@
 #include "utils/wait_for_event.h"
 /*-----------------------------------------------------------*/
 
+/*
+ * By default the tick thread sleeps until each deadline with
+ * clock_nanosleep(). Setting configPOSIX_TICK_USE_TIMERFD to 1 (Linux only)
+ * makes it block on a periodic timerfd instead, which reports overruns
+ * without the thread having to read the clock.
+ */
+#ifndef configPOSIX_TICK_USE_TIMERFD
+    #define configPOSIX_TICK_USE_TIMERFD    0
+#endif
+
+#if ( configPOSIX_TICK_USE_TIMERFD == 1 )
+    #ifndef __linux__
+        #error configPOSIX_TICK_USE_TIMERFD requires Linux
+    #endif
+    #include <sys/timerfd.h>
+#endif
+
+/*
+ * By default critical sections block signals with pthread_sigmask(), which
+ * is a system call on every entry and exit. Setting
+ * configPOSIX_LAZY_INTERRUPT_MASK to 1 makes them set a per-thread flag
+ * instead. A tick that arrives while the flag is set is only noted by the
+ * handler, and raised again when the critical section is left. Only the tick
+ * is deferred this way, as it is the only interrupt the port emulates.
+ */
+#ifndef configPOSIX_LAZY_INTERRUPT_MASK
+    #define configPOSIX_LAZY_INTERRUPT_MASK    0
+#endif
+
+/*
+ * The size of the stack of each task's pthread, in bytes. 0 leaves it to the
+ * C library, which on Linux reserves 8 MiB of address space per thread. Pages
+ * are only committed as the task touches them, but where many tasks are live
+ * the reservation, and the page tables behind it, add up.
+ */
+#ifndef configPOSIX_THREAD_STACK_SIZE
+    #define configPOSIX_THREAD_STACK_SIZE    0
+#endif
+
+#if ( configTICK_RATE_HZ > 1000000 )
+    #error The Posix port does not support tick rates above 1 MHz
+#endif
+/*-----------------------------------------------------------*/
+
 #define SIG_RESUME    SIGUSR1
 
 typedef struct THREAD
@@ -86,6 +138,10 @@ typedef struct THREAD
     void * pvParams;
     BaseType_t xDying;
     struct event * ev;
+    #ifdef __linux__
+        uintptr_t uxStackLow;  /* Lowest usable address of the pthread stack. */
+        size_t uxStackSize;
+    #endif
 } Thread_t;
 
 /*
@@ -112,6 +168,39 @@ static pthread_t hTimerTickThread;
 static bool xTimerTickThreadShouldRun;
 static uint64_t prvStartTimeNs;
 static pthread_key_t xThreadKey = 0;
+
+/* The thread a tick signal has been sent to but not yet handled by, the
+ * deadline of the latest tick raised and the number of tick periods elapsed
+ * since the scheduler started. Written by the tick thread, consumed by the
+ * tick handler. */
+static Thread_t * volatile pxTickPendingThread = NULL;
+static volatile uint64_t ullTickRaisedNs;
+static volatile uint64_t ullTicksRaised;
+
+/* The number of ticks passed to xTaskIncrementTick() so far. */
+static uint64_t ullTicksProcessed;
+static uint64_t ullLastTickLatencyNs;
+static PortTickStats_t xTickStats = { .ullLatencyMinNs = UINT64_MAX };
+
+/* Origin of the run time stats counter. */
+static uint64_t ullRunTimeStartNs;
+
+#if ( configPOSIX_LAZY_INTERRUPT_MASK == 1 )
+
+/* Set while the thread is in a critical section, and set by the tick handler
+ * when it had to defer a tick because of that. Only accessed by the owning
+ * thread and its signal handler. */
+    static __thread volatile sig_atomic_t xInterruptsMasked;
+    static __thread volatile sig_atomic_t xTickDeferred;
+#endif
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+/* Second level of the ready priority bitmap, see portGET_HIGHEST_PRIORITY().
+ * Only accessed by the kernel with interrupts masked.  Sized here because
+ * portmacro.h was included before FreeRTOSConfig.h in this file. */
+    uint64_t ullPortReadyPriorities[ ( configMAX_PRIORITIES + 63 ) / 64 ];
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
@@ -129,6 +218,13 @@ static void prvInitThreadKey( void );
 static void prvMarkAsFreeRTOSThread( void );
 static BaseType_t prvIsFreeRTOSThread( void );
 static void prvDestroyThreadKey( void );
+static uint64_t prvGetTimeNs( void );
+#ifdef __linux__
+    static void prvGetThreadStack( pthread_t xThread,
+                                   uintptr_t * puxLow,
+                                   size_t * puxSize );
+    static void prvReleaseUnusedStack( void );
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvThreadKeyDestructor( void * pvData )
@@ -215,6 +311,7 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 {
     Thread_t * thread;
     pthread_attr_t xThreadAttributes;
+    sigset_t xCreatorSignalMask;
     size_t ulStackSize;
     int iRet;
 
@@ -237,18 +334,46 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 
     pthread_attr_init( &xThreadAttributes );
 
+    #if ( configPOSIX_THREAD_STACK_SIZE > 0 )
+    {
+        iRet = pthread_attr_setstacksize( &xThreadAttributes, configPOSIX_THREAD_STACK_SIZE );
+
+        if( iRet != 0 )
+        {
+            prvFatalError( "pthread_attr_setstacksize", iRet );
+        }
+    }
+    #endif
+
     thread->ev = event_create();
 
     vPortEnterCritical();
 
+    /* A new thread inherits the signal mask of its creator.  With
+     * configPOSIX_LAZY_INTERRUPT_MASK a running task has all signals
+     * unblocked, so block them around the create: the new thread must not
+     * take a tick until prvWaitForStart() has been resumed for the first
+     * time. */
+    ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xCreatorSignalMask );
+
     iRet = pthread_create( &thread->pthread, &xThreadAttributes,
                            prvWaitForStart, thread );
 
+    ( void ) pthread_sigmask( SIG_SETMASK, &xCreatorSignalMask, NULL );
+
     if( iRet != 0 )
     {
         prvFatalError( "pthread_create", iRet );
     }
 
+    pthread_attr_destroy( &xThreadAttributes );
+
+    #ifdef __linux__
+    {
+        prvGetThreadStack( thread->pthread, &thread->uxStackLow, &thread->uxStackSize );
+    }
+    #endif
+
     vPortExitCritical();
 
     return pxTopOfStack;
@@ -407,7 +532,15 @@ void vPortDisableInterrupts( void )
 {
     if( prvIsFreeRTOSThread() == pdTRUE )
     {
-        pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+        #if ( configPOSIX_LAZY_INTERRUPT_MASK == 1 )
+            xInterruptsMasked = 1;
+
+            /* Keep the critical section from being moved above the flag. The
+             * handler runs on this thread, so no hardware barrier is needed. */
+            portMEMORY_BARRIER();
+        #else
+            pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -416,7 +549,22 @@ void vPortEnableInterrupts( void )
 {
     if( prvIsFreeRTOSThread() == pdTRUE )
     {
-        pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+        #if ( configPOSIX_LAZY_INTERRUPT_MASK == 1 )
+            portMEMORY_BARRIER();
+            xInterruptsMasked = 0;
+            portMEMORY_BARRIER();
+
+            /* A tick that arrives after the flag is cleared is handled
+             * straight away, so at worst the tick below finds nothing left to
+             * process. */
+            if( xTickDeferred != 0 )
+            {
+                xTickDeferred = 0;
+                pthread_kill( pthread_self(), SIGALRM );
+            }
+        #else
+            pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -449,6 +597,83 @@ static uint64_t prvGetTimeNs( void )
  * to adjust timing according to full demo requirements */
 /* static uint64_t prvTickCount; */
 
+static void prvRaiseTick( uint64_t ullTickNumber )
+{
+    /*
+     * signal to the active task to cause tick handling or
+     * preemption (if enabled)
+     */
+    Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    ullTicksRaised = ullTickNumber;
+
+    if( pxTickPendingThread == thread )
+    {
+        /* The previous tick has not been handled by this thread yet. A second
+         * SIGALRM would only be merged with the pending one by the kernel. */
+        xTickStats.ullTicksCoalesced++;
+    }
+    else
+    {
+        ullTickRaisedNs = prvStartTimeNs + ( ullTickNumber * portTICK_RATE_NANOSECONDS );
+        pxTickPendingThread = thread;
+        pthread_kill( thread->pthread, SIGALRM );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configPOSIX_TICK_USE_TIMERFD == 1 )
+
+    static int prvCreateTickTimer( void )
+    {
+        struct itimerspec xTimerSpec;
+        uint64_t ullFirstDeadlineNs = prvStartTimeNs + portTICK_RATE_NANOSECONDS;
+        int iTimerFd;
+
+        iTimerFd = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC );
+
+        if( iTimerFd == -1 )
+        {
+            prvFatalError( "timerfd_create", errno );
+        }
+
+        xTimerSpec.it_interval.tv_sec = ( time_t ) ( portTICK_RATE_NANOSECONDS / 1000000000ULL );
+        xTimerSpec.it_interval.tv_nsec = ( long ) ( portTICK_RATE_NANOSECONDS % 1000000000ULL );
+        xTimerSpec.it_value.tv_sec = ( time_t ) ( ullFirstDeadlineNs / 1000000000ULL );
+        xTimerSpec.it_value.tv_nsec = ( long ) ( ullFirstDeadlineNs % 1000000000ULL );
+
+        if( timerfd_settime( iTimerFd, TFD_TIMER_ABSTIME, &xTimerSpec, NULL ) == -1 )
+        {
+            prvFatalError( "timerfd_settime", errno );
+        }
+
+        return iTimerFd;
+    }
+
+#else /* configPOSIX_TICK_USE_TIMERFD */
+
+    static void prvSleepUntil( uint64_t ullDeadlineNs )
+    {
+        struct timespec xDeadline;
+        int iRet;
+
+        xDeadline.tv_sec = ( time_t ) ( ullDeadlineNs / 1000000000ULL );
+        xDeadline.tv_nsec = ( long ) ( ullDeadlineNs % 1000000000ULL );
+
+        do
+        {
+            iRet = clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xDeadline, NULL );
+        } while( iRet == EINTR );
+
+        if( iRet != 0 )
+        {
+            prvFatalError( "clock_nanosleep", iRet );
+        }
+    }
+
+#endif /* configPOSIX_TICK_USE_TIMERFD */
+/*-----------------------------------------------------------*/
+
 static void * prvTimerTickHandler( void * arg )
 {
     ( void ) arg;
@@ -457,16 +682,50 @@ static void * prvTimerTickHandler( void * arg )
 
     prvPortSetCurrentThreadName( "Scheduler timer" );
 
-    while( xTimerTickThreadShouldRun )
+    #if ( configPOSIX_TICK_USE_TIMERFD == 1 )
     {
-        /*
-         * signal to the active task to cause tick handling or
-         * preemption (if enabled)
-         */
-        Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
-        pthread_kill( thread->pthread, SIGALRM );
-        usleep( portTICK_RATE_MICROSECONDS );
+        int iTimerFd = prvCreateTickTimer();
+        uint64_t ullExpirations;
+        uint64_t ullTotalExpirations = 0;
+        ssize_t xBytesRead;
+
+        while( xTimerTickThreadShouldRun )
+        {
+            xBytesRead = read( iTimerFd, &ullExpirations, sizeof( ullExpirations ) );
+
+            if( xBytesRead != ( ssize_t ) sizeof( ullExpirations ) )
+            {
+                if( ( xBytesRead == -1 ) && ( errno == EINTR ) )
+                {
+                    continue;
+                }
+
+                prvFatalError( "read", errno );
+            }
+
+            /* More than one expiration means this thread overran a period.
+             * The handler catches up on all of them. */
+            ullTotalExpirations += ullExpirations;
+            prvRaiseTick( ullTotalExpirations );
+        }
+
+        close( iTimerFd );
     }
+    #else /* configPOSIX_TICK_USE_TIMERFD */
+    {
+        uint64_t ullTickNumber = 0;
+
+        while( xTimerTickThreadShouldRun )
+        {
+            prvSleepUntil( prvStartTimeNs + ( ( ullTickNumber + 1 ) * portTICK_RATE_NANOSECONDS ) );
+
+            /* Count every deadline that has passed, which may be more than one
+             * if this thread was not scheduled in time. */
+            ullTickNumber = ( prvGetTimeNs() - prvStartTimeNs ) / portTICK_RATE_NANOSECONDS;
+            prvRaiseTick( ullTickNumber );
+        }
+    }
+    #endif /* configPOSIX_TICK_USE_TIMERFD */
 
     return NULL;
 }
@@ -478,10 +737,126 @@ static void * prvTimerTickHandler( void * arg )
  */
 void prvSetupTimerInterrupt( void )
 {
+    /* The tick deadlines are derived from the start time, so it must be known
+     * before the tick thread is created. */
+    prvStartTimeNs = prvGetTimeNs();
+    ullTicksRaised = 0;
+    ullTicksProcessed = 0;
+
     xTimerTickThreadShouldRun = true;
     pthread_create( &hTimerTickThread, NULL, prvTimerTickHandler, NULL );
+}
+/*-----------------------------------------------------------*/
 
-    prvStartTimeNs = prvGetTimeNs();
+static void prvRecordTickLatency( Thread_t * pxThread )
+{
+    uint64_t ullNow;
+    uint64_t ullLatency = 0;
+    uint64_t ullJitter;
+
+    if( pxTickPendingThread != pxThread )
+    {
+        /* A stale signal that was raised before this thread was switched out
+         * and is only delivered now that it runs again. */
+        return;
+    }
+
+    ullNow = prvGetTimeNs();
+
+    if( ullNow > ullTickRaisedNs )
+    {
+        ullLatency = ullNow - ullTickRaisedNs;
+    }
+
+    pxTickPendingThread = NULL;
+
+    if( xTickStats.ullTicksHandled > 0 )
+    {
+        ullJitter = ( ullLatency > ullLastTickLatencyNs ) ? ( ullLatency - ullLastTickLatencyNs ) : ( ullLastTickLatencyNs - ullLatency );
+        xTickStats.ullJitterTotalNs += ullJitter;
+
+        if( ullJitter > xTickStats.ullJitterMaxNs )
+        {
+            xTickStats.ullJitterMaxNs = ullJitter;
+        }
+    }
+
+    if( ullLatency < xTickStats.ullLatencyMinNs )
+    {
+        xTickStats.ullLatencyMinNs = ullLatency;
+    }
+
+    if( ullLatency > xTickStats.ullLatencyMaxNs )
+    {
+        xTickStats.ullLatencyMaxNs = ullLatency;
+    }
+
+    xTickStats.ullLatencyTotalNs += ullLatency;
+    xTickStats.ullTicksHandled++;
+    ullLastTickLatencyNs = ullLatency;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the number of ticks that have elapsed but have not yet been passed
+ * to the kernel. Normally 1, 0 for a stale signal and more than 1 when ticks
+ * were late or merged.
+ */
+static uint64_t prvTakeTicksToProcess( void )
+{
+    uint64_t ullRaised = ullTicksRaised;
+    uint64_t ullTicksToProcess = 0;
+    uint64_t ullLagNs;
+
+    if( ullRaised > ullTicksProcessed )
+    {
+        ullTicksToProcess = ullRaised - ullTicksProcessed;
+        ullLagNs = ( ullTicksToProcess - 1 ) * portTICK_RATE_NANOSECONDS;
+
+        if( ullTicksToProcess > 1 )
+        {
+            xTickStats.ullTicksCaughtUp += ullTicksToProcess - 1;
+        }
+
+        if( ullTicksToProcess > xTickStats.ullMaxTicksPerHandler )
+        {
+            xTickStats.ullMaxTicksPerHandler = ullTicksToProcess;
+        }
+
+        if( ullLagNs > xTickStats.ullDriftMaxNs )
+        {
+            xTickStats.ullDriftMaxNs = ullLagNs;
+        }
+
+        ullTicksProcessed = ullRaised;
+    }
+
+    return ullTicksToProcess;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTickStats( PortTickStats_t * pxTickStats )
+{
+    configASSERT( pxTickStats != NULL );
+
+    vPortEnterCritical();
+    {
+        *pxTickStats = xTickStats;
+        pxTickStats->ullTicksElapsed = ( prvGetTimeNs() - prvStartTimeNs ) / portTICK_RATE_NANOSECONDS;
+        pxTickStats->ullTicksProcessed = ullTicksProcessed;
+    }
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortResetTickStats( void )
+{
+    vPortEnterCritical();
+    {
+        memset( &xTickStats, 0, sizeof( xTickStats ) );
+        xTickStats.ullLatencyMinNs = UINT64_MAX;
+    }
+    vPortExitCritical();
 }
 /*-----------------------------------------------------------*/
 
@@ -491,14 +866,46 @@ static void vPortSystemTickHandler( int sig )
     {
         Thread_t * pxThreadToSuspend;
         Thread_t * pxThreadToResume;
+        uint64_t ullTicksToProcess;
+        BaseType_t xSwitchRequired = pdFALSE;
 
         ( void ) sig;
 
+        #if ( configPOSIX_LAZY_INTERRUPT_MASK == 1 )
+        {
+            if( xInterruptsMasked != 0 )
+            {
+                /* Interrupted a critical section. pxTickPendingThread is left
+                 * alone so further ticks are merged into this one until
+                 * vPortEnableInterrupts() raises it again. */
+                xTickDeferred = 1;
+                return;
+            }
+        }
+        #endif
+
         uxCriticalNesting++; /* Signals are blocked in this signal handler. */
 
         pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-        if( xTaskIncrementTick() != pdFALSE )
+        prvRecordTickLatency( pxThreadToSuspend );
+
+        /* xTaskCatchUpTicks() cannot be used from here as it suspends the
+         * scheduler and may yield, so missed ticks are replayed one by one
+         * exactly as if each had been delivered on time. */
+        ullTicksToProcess = prvTakeTicksToProcess();
+
+        while( ullTicksToProcess > 0 )
+        {
+            if( xTaskIncrementTick() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+
+            ullTicksToProcess--;
+        }
+
+        if( xSwitchRequired != pdFALSE )
         {
             /* Select Next Task. */
             vTaskSwitchContext();
@@ -532,6 +939,13 @@ void vPortCancelThread( void * pxTaskToDelete )
 {
     Thread_t * pxThreadToCancel = prvGetThreadFromTask( pxTaskToDelete );
 
+    /* The Thread_t lives on the task's stack and may be reused by the next
+     * task that is created, so forget any tick still pending on it. */
+    if( pxTickPendingThread == pxThreadToCancel )
+    {
+        pxTickPendingThread = NULL;
+    }
+
     /*
      * The thread has already been suspended so it can be safely cancelled.
      */
@@ -548,10 +962,25 @@ static void * prvWaitForStart( void * pvParams )
 
     prvMarkAsFreeRTOSThread();
 
+    #ifdef __linux__
+    {
+        prvReleaseUnusedStack();
+    }
+    #endif
+
     prvSuspendSelf( pxThread );
 
-    /* Resumed for the first time, unblocks all signals. */
+    /* Resumed for the first time, unblocks all signals.  Until here the
+     * thread has run with every signal blocked, as it was created. */
     uxCriticalNesting = 0;
+
+    #if ( configPOSIX_LAZY_INTERRUPT_MASK == 1 )
+    {
+        /* From here on only the per-thread flag masks the tick. */
+        pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+    }
+    #endif
+
     vPortEnableInterrupts();
 
     /* Set thread name */
@@ -571,6 +1000,146 @@ static void * prvWaitForStart( void * pvParams )
 }
 /*-----------------------------------------------------------*/
 
+#ifdef __linux__
+
+    static void prvGetThreadStack( pthread_t xThread,
+                                   uintptr_t * puxLow,
+                                   size_t * puxSize )
+    {
+        pthread_attr_t xAttr;
+        void * pvLow = NULL;
+        size_t uxSize = 0;
+        int iRet;
+
+        iRet = pthread_getattr_np( xThread, &xAttr );
+
+        if( iRet != 0 )
+        {
+            prvFatalError( "pthread_getattr_np", iRet );
+        }
+
+        ( void ) pthread_attr_getstack( &xAttr, &pvLow, &uxSize );
+        ( void ) pthread_attr_destroy( &xAttr );
+
+        *puxLow = ( uintptr_t ) pvLow;
+        *puxSize = uxSize;
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * The C library keeps the stacks of threads that have been joined for reuse,
+ * and pages a previous task touched would count as used by this one. Return
+ * every page below the current frame to the kernel, leaving one page spare
+ * for the calls still to be made from here. Only called before the thread
+ * first runs, when pxPortInitialiseStack() has created it with every signal
+ * blocked, so no handler can be running on those pages. That is checked
+ * rather than assumed, as zeroing a live handler frame would be silent.
+ */
+    static void prvReleaseUnusedStack( void )
+    {
+        const uintptr_t uxPageSize = ( uintptr_t ) sysconf( _SC_PAGESIZE );
+        uintptr_t uxLow;
+        uintptr_t uxHigh;
+        size_t uxSize;
+        sigset_t xBlocked;
+        BaseType_t xSignalsBlocked = pdTRUE;
+        int iSignal;
+
+        ( void ) pthread_sigmask( SIG_BLOCK, NULL, &xBlocked );
+
+        for( iSignal = 1; iSignal < NSIG; iSignal++ )
+        {
+            /* SIGKILL and SIGSTOP cannot be blocked, nor caught. */
+            if( ( sigismember( &xAllSignals, iSignal ) == 1 ) &&
+                ( sigismember( &xBlocked, iSignal ) != 1 ) &&
+                ( iSignal != SIGKILL ) && ( iSignal != SIGSTOP ) )
+            {
+                /* A handler could run on this stack, keep the pages. */
+                xSignalsBlocked = pdFALSE;
+            }
+        }
+
+        prvGetThreadStack( pthread_self(), &uxLow, &uxSize );
+
+        uxLow = ( uxLow + uxPageSize - 1 ) & ~( uxPageSize - 1 );
+        uxHigh = ( ( uintptr_t ) __builtin_frame_address( 0 ) & ~( uxPageSize - 1 ) ) - uxPageSize;
+
+        if( ( xSignalsBlocked != pdFALSE ) && ( uxHigh > uxLow ) )
+        {
+            ( void ) madvise( ( void * ) uxLow, uxHigh - uxLow, MADV_DONTNEED );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * A stack only grows down into pages as it touches them, so the lowest
+ * resident page marks the deepest the task has been. Only pages are seen,
+ * so the result is rounded down to a page.
+ */
+    UBaseType_t uxPortGetStackHighWaterMark( const void * pxTCB )
+    {
+        const Thread_t * pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTCB );
+        const uintptr_t uxPageSize = ( uintptr_t ) sysconf( _SC_PAGESIZE );
+        const uintptr_t uxLow = ( pxThread->uxStackLow + uxPageSize - 1 ) & ~( uxPageSize - 1 );
+        const uintptr_t uxHigh = pxThread->uxStackLow + pxThread->uxStackSize;
+        unsigned char ucResident[ 512 ];
+        uintptr_t uxPage = uxLow;
+        size_t uxPages;
+        size_t x;
+
+        while( uxPage < uxHigh )
+        {
+            uxPages = ( size_t ) ( ( uxHigh - uxPage + uxPageSize - 1 ) / uxPageSize );
+
+            if( uxPages > sizeof( ucResident ) )
+            {
+                uxPages = sizeof( ucResident );
+            }
+
+            if( mincore( ( void * ) uxPage, uxPages * uxPageSize, ucResident ) != 0 )
+            {
+                break;
+            }
+
+            for( x = 0; x < uxPages; x++ )
+            {
+                if( ( ucResident[ x ] & 1U ) != 0U )
+                {
+                    return ( UBaseType_t ) ( ( uxPage + ( x * uxPageSize ) - pxThread->uxStackLow ) / sizeof( StackType_t ) );
+                }
+            }
+
+            uxPage += uxPages * uxPageSize;
+        }
+
+        return ( UBaseType_t ) ( ( uxPage - pxThread->uxStackLow ) / sizeof( StackType_t ) );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetTaskFootprint( void * xTask,
+                                PortTaskFootprint_t * pxFootprint )
+    {
+        const Thread_t * pxThread;
+        size_t uxFree;
+
+        if( xTask == NULL )
+        {
+            xTask = xTaskGetCurrentTaskHandle();
+        }
+
+        pxThread = prvGetThreadFromTask( xTask );
+        uxFree = ( size_t ) uxPortGetStackHighWaterMark( xTask ) * sizeof( StackType_t );
+
+        pxFootprint->uxTCBBytes = sizeof( StaticTask_t );
+        pxFootprint->uxKernelStackBytes = portTHREAD_STACK_DEPTH * sizeof( StackType_t );
+        pxFootprint->uxEventBytes = event_size();
+        pxFootprint->uxThreadStackBytes = pxThread->uxStackSize;
+        pxFootprint->uxThreadStackUsedBytes = ( uxFree < pxThread->uxStackSize ) ? ( pxThread->uxStackSize - uxFree ) : 0U;
+    }
+
+#endif /* __linux__ */
+/*-----------------------------------------------------------*/
+
 static void prvSwitchThread( Thread_t * pxThreadToResume,
                              Thread_t * pxThreadToSuspend )
 {
@@ -610,7 +1179,8 @@ static void prvSuspendSelf( Thread_t * thread )
      * all signals must be blocked by calling this from:
      *
      * - Inside a critical section (vPortEnterCritical() /
-     *   vPortExitCritical()).
+     *   vPortExitCritical()). With configPOSIX_LAZY_INTERRUPT_MASK the
+     *   signal is still delivered, but the handler only defers it.
      *
      * - From a signal handler that has all signals masked.
      *
@@ -656,7 +1226,13 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
                               &xAllSignals,
                               &xSchedulerOriginalSignalMask );
 
-    sigtick.sa_flags = 0;
+    #if ( configPOSIX_LAZY_INTERRUPT_MASK == 1 )
+        /* Ticks can now arrive inside critical sections, which may be in the
+         * middle of a system call. */
+        sigtick.sa_flags = SA_RESTART;
+    #else
+        sigtick.sa_flags = 0;
+    #endif
     sigtick.sa_handler = vPortSystemTickHandler;
     sigfillset( &sigtick.sa_mask );
 
@@ -678,3 +1254,19 @@ uint32_t ulPortGetRunTime( void )
     return ( uint32_t ) xTimes.tms_utime;
 }
 /*-----------------------------------------------------------*/
+
+void vPortConfigureRunTimeCounter( void )
+{
+    ullRunTimeStartNs = prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetRunTimeCounterValue( void )
+{
+    /* Wall clock rather than thread CPU time: only one task thread runs at a
+     * time, so the time between two context switches is the time the task
+     * switched out was running, including any time the host took the CPU
+     * away from the whole process. */
+    return prvGetTimeNs() - ullRunTimeStartNs;
+}
+/*-----------------------------------------------------------*/
@@ -37,6 +37,7 @@
 /* *INDENT-ON* */
 
 #include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /*-----------------------------------------------------------
@@ -75,6 +76,7 @@ typedef unsigned long    TickType_t;
 #define portHAS_STACK_OVERFLOW_CHECKING    ( 1 )
 #define portTICK_PERIOD_MS                 ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portTICK_RATE_MICROSECONDS         ( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
+#define portTICK_RATE_NANOSECONDS          ( ( uint64_t ) 1000000000 / configTICK_RATE_HZ )
 #define portBYTE_ALIGNMENT                 8
 /*-----------------------------------------------------------*/
 
@@ -99,6 +101,70 @@ extern void vPortYield( void );
 #define portYIELD_FROM_ISR( x )    portEND_SWITCHING_ISR( x )
 /*-----------------------------------------------------------*/
 
+/* Port optimised task selection.  port.c includes this file before
+ * FreeRTOSConfig.h, hence the defined() test. */
+#if defined( configUSE_PORT_OPTIMISED_TASK_SELECTION ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+/* The ready priorities are kept in a two level bitmap so that far more than
+ * the usual 32 priorities can be selected in constant time.  Priorities are
+ * grouped 64 to a word of ullPortReadyPriorities[], and bit n of the kernel's
+ * uxTopReadyPriority is set while word n is non-zero.  Selection is then two
+ * count-leading-zeros operations, whatever the number of priorities. */
+    #if ( ULONG_MAX > 0xffffffffUL )
+        #define portMAX_PRIORITY_GROUPS    64
+    #else
+        #define portMAX_PRIORITY_GROUPS    32
+    #endif
+
+    #if ( configMAX_PRIORITIES > ( portMAX_PRIORITY_GROUPS * 64 ) )
+        #error configMAX_PRIORITIES is too large for the two level ready priority bitmap.
+    #endif
+
+    #define portPRIORITY_GROUP_COUNT    ( ( configMAX_PRIORITIES + 63 ) / 64 )
+    #define portPRIORITY_GROUP( uxPriority )    ( ( UBaseType_t ) ( uxPriority ) >> 6 )
+    #define portPRIORITY_BIT( uxPriority )      ( ( uint64_t ) 1 << ( ( UBaseType_t ) ( uxPriority ) & ( UBaseType_t ) 63 ) )
+
+    extern uint64_t ullPortReadyPriorities[ portPRIORITY_GROUP_COUNT ];
+
+    #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )                  \
+    do {                                                                                \
+        ullPortReadyPriorities[ portPRIORITY_GROUP( uxPriority ) ] |= portPRIORITY_BIT( uxPriority ); \
+        ( uxReadyPriorities ) |= ( ( UBaseType_t ) 1 << portPRIORITY_GROUP( uxPriority ) );           \
+    } while( 0 )
+
+    #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )                                  \
+    do {                                                                                               \
+        ullPortReadyPriorities[ portPRIORITY_GROUP( uxPriority ) ] &= ~portPRIORITY_BIT( uxPriority ); \
+                                                                                                       \
+        if( ullPortReadyPriorities[ portPRIORITY_GROUP( uxPriority ) ] == ( uint64_t ) 0 )            \
+        {                                                                                              \
+            ( uxReadyPriorities ) &= ~( ( UBaseType_t ) 1 << portPRIORITY_GROUP( uxPriority ) );      \
+        }                                                                                              \
+    } while( 0 )
+
+    #define portRESET_ALL_READY_PRIORITIES( uxReadyPriorities )                  \
+    do {                                                                      \
+        UBaseType_t uxGroup;                                                  \
+                                                                              \
+        for( uxGroup = 0U; uxGroup < portPRIORITY_GROUP_COUNT; uxGroup++ )    \
+        {                                                                     \
+            ullPortReadyPriorities[ uxGroup ] = ( uint64_t ) 0;               \
+        }                                                                     \
+                                                                              \
+        ( uxReadyPriorities ) = ( UBaseType_t ) 0;                            \
+    } while( 0 )
+
+    #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )                                                        \
+    do {                                                                                                                        \
+        const UBaseType_t uxGroup = ( UBaseType_t ) ( portMAX_PRIORITY_GROUPS - 1 ) -                                          \
+                                    ( UBaseType_t ) __builtin_clzl( ( unsigned long ) ( uxReadyPriorities ) );                 \
+        ( uxTopPriority ) = ( uxGroup << 6 ) +                                                                                  \
+                            ( ( UBaseType_t ) 63 - ( UBaseType_t ) __builtin_clzll( ( unsigned long long ) ullPortReadyPriorities[ uxGroup ] ) ); \
+    } while( 0 )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
 /* Critical section management. */
 extern void vPortDisableInterrupts( void );
 extern void vPortEnableInterrupts( void );
@@ -126,6 +192,34 @@ extern void vPortCancelThread( void * pxTaskToDelete );
 #define portCLEAN_UP_TCB( pxTCB )                                  vPortCancelThread( pxTCB )
 /*-----------------------------------------------------------*/
 
+/* Tasks run on the stacks of their pthreads, so the kernel only allocates
+ * enough of a stack to hold the port's per-thread data. The stack high water
+ * mark is then taken from the pages of the pthread stack that have been
+ * touched, as reported by mincore(). */
+#ifdef __linux__
+    #define portTHREAD_STACK_DEPTH    32U
+    extern UBaseType_t uxPortGetStackHighWaterMark( const void * pxTCB );
+    #define portTASK_STACK_DEPTH( uxStackDepth )         ( ( void ) ( uxStackDepth ), portTHREAD_STACK_DEPTH )
+    #define portGET_STACK_HIGH_WATER_MARK( pxTCB )       uxPortGetStackHighWaterMark( pxTCB )
+
+/* Used to pass the memory a task costs out of vPortGetTaskFootprint(). All
+ * sizes are in bytes. The thread stack is address space reserved by the C
+ * library, of which only the used part is backed by memory; it is sized by
+ * configPOSIX_THREAD_STACK_SIZE. */
+    typedef struct xPORT_TASK_FOOTPRINT
+    {
+        size_t uxTCBBytes;             /* Task control block, from the FreeRTOS heap. */
+        size_t uxKernelStackBytes;     /* Stack allocated by the kernel, which only holds the port's thread data. */
+        size_t uxEventBytes;           /* Event the thread is suspended on, from the C library heap. */
+        size_t uxThreadStackBytes;     /* pthread stack reserved, excluding the guard page. */
+        size_t uxThreadStackUsedBytes; /* Part of the pthread stack the task has touched, including the C library's thread descriptor. */
+    } PortTaskFootprint_t;
+
+    extern void vPortGetTaskFootprint( void * xTask,
+                                       PortTaskFootprint_t * pxFootprint );
+#endif
+/*-----------------------------------------------------------*/
+
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters )         void vFunction( void * pvParameters ) __attribute__( ( noreturn ) )
 #define portTASK_FUNCTION( vFunction, pvParameters )               void vFunction( void * pvParameters )
 /*-----------------------------------------------------------*/
@@ -140,9 +234,43 @@ extern void vPortCancelThread( void * pxTaskToDelete );
  */
 #define portMEMORY_BARRIER()                        __asm volatile ( "" ::: "memory" )
 
+/* Used to pass tick timing information out of vPortGetTickStats().
+ * Latency is measured from the deadline of a tick until the tick handler runs
+ * on the thread of the current task. Jitter is the difference between the
+ * latencies of two consecutive ticks. Drift is how far the kernel tick count
+ * lagged behind wall-clock time when a handler ran. All times are in
+ * nanoseconds. */
+typedef struct xPORT_TICK_STATS
+{
+    uint64_t ullTicksHandled;       /* Number of tick handler invocations that were measured. */
+    uint64_t ullTicksCoalesced;     /* Number of ticks raised while the previous tick signal was still pending on the same thread. */
+    uint64_t ullLatencyMinNs;
+    uint64_t ullLatencyMaxNs;
+    uint64_t ullLatencyTotalNs;     /* Divide by ullTicksHandled for the mean latency. */
+    uint64_t ullJitterMaxNs;
+    uint64_t ullJitterTotalNs;      /* Divide by ( ullTicksHandled - 1 ) for the mean jitter. */
+    uint64_t ullTicksElapsed;       /* Tick periods elapsed since the scheduler started, at the time of the call. */
+    uint64_t ullTicksProcessed;     /* Ticks passed to the kernel so far. Trails ullTicksElapsed by the current drift. */
+    uint64_t ullTicksCaughtUp;      /* Ticks that were processed late, together with a later tick. */
+    uint64_t ullMaxTicksPerHandler; /* Largest number of ticks processed by a single handler invocation. */
+    uint64_t ullDriftMaxNs;         /* Largest lag behind wall-clock time that had to be caught up. */
+} PortTickStats_t;
+
+extern void vPortGetTickStats( PortTickStats_t * pxTickStats );
+extern void vPortResetTickStats( void );
+
+/* The run time stats counter counts nanoseconds of CLOCK_MONOTONIC since the
+ * scheduler was started, so configRUN_TIME_COUNTER_TYPE should be uint64_t -
+ * a 32-bit counter wraps after about 4.3 seconds. */
 extern uint32_t ulPortGetRunTime( void );
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
-#define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
+extern void vPortConfigureRunTimeCounter( void );
+extern uint64_t ullPortGetRunTimeCounterValue( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortConfigureRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE()            ullPortGetRunTimeCounterValue()
+
+/* long is wider than int on the hosts this port runs on, so the stats
+ * formatting functions must print counters with %lu. */
+#define portLU_PRINTF_SPECIFIER_REQUIRED
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -0,0 +1,320 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "trace_recorder.h"
+
+#define traceBUFFER_INDEX_MASK    ( ( uint64_t ) configTRACE_RECORDER_BUFFER_RECORDS - 1U )
+
+typedef struct xTRACE_BUFFER
+{
+    uint64_t ullHead; /* Total number of records ever reserved. */
+    uint32_t ulThreadId;
+    TraceRecord_t xRecords[ configTRACE_RECORDER_BUFFER_RECORDS ];
+} TraceBuffer_t;
+
+/* The pool lives in .bss, so pages are only touched by threads that record. */
+static TraceBuffer_t xBuffers[ configTRACE_RECORDER_MAX_THREADS ];
+static uint32_t ulBuffersClaimed = 0;
+static uint32_t ulEventsDropped = 0;
+
+static TraceObjectName_t xObjectNames[ configTRACE_RECORDER_MAX_OBJECTS ];
+static uint32_t ulObjectsClaimed = 0;
+
+static __thread TraceBuffer_t * pxThreadBuffer = NULL;
+static __thread int iThreadHasNoBuffer = 0;
+
+static uint64_t ullFirstTicks = 0;
+static uint64_t ullFirstNs = 0;
+
+static const char * pcDumpFileName = NULL;
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec t;
+
+    clock_gettime( CLOCK_MONOTONIC, &t );
+
+    return ( uint64_t ) t.tv_sec * ( uint64_t ) 1000000000UL + ( uint64_t ) t.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static inline uint64_t prvGetTimestamp( void )
+{
+    #if defined( __x86_64__ )
+        return __builtin_ia32_rdtsc();
+    #else
+        return prvGetTimeNs();
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvClampedCount( const uint32_t * pulClaimed,
+                                 uint32_t ulMax )
+{
+    uint32_t ulCount = __atomic_load_n( pulClaimed, __ATOMIC_ACQUIRE );
+
+    return ( ulCount < ulMax ) ? ulCount : ulMax;
+}
+/*-----------------------------------------------------------*/
+
+static TraceBuffer_t * prvClaimBuffer( void )
+{
+    TraceBuffer_t * pxBuffer = NULL;
+    uint32_t ulIndex;
+
+    /* Only called once per thread, the first time it records an event.  If a
+     * signal handler on the same thread gets here first the interrupted call
+     * claims a second buffer, which costs a slot but loses nothing. */
+    ulIndex = __atomic_fetch_add( &ulBuffersClaimed, 1U, __ATOMIC_ACQ_REL );
+
+    if( ulIndex == 0U )
+    {
+        /* First reference point for converting timestamps to nanoseconds. */
+        ullFirstNs = prvGetTimeNs();
+        ullFirstTicks = prvGetTimestamp();
+    }
+
+    if( ulIndex < configTRACE_RECORDER_MAX_THREADS )
+    {
+        pxBuffer = &xBuffers[ ulIndex ];
+        pxBuffer->ulThreadId = ( uint32_t ) syscall( SYS_gettid );
+        pxThreadBuffer = pxBuffer;
+    }
+    else
+    {
+        iThreadHasNoBuffer = 1;
+    }
+
+    return pxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecord( uint32_t ulEvent,
+                   const volatile void * pvObject,
+                   uint64_t ullValue )
+{
+    TraceBuffer_t * pxBuffer = pxThreadBuffer;
+    TraceRecord_t * pxRecord;
+    uint64_t ullSlot;
+
+    if( pxBuffer == NULL )
+    {
+        if( iThreadHasNoBuffer == 0 )
+        {
+            pxBuffer = prvClaimBuffer();
+        }
+
+        if( pxBuffer == NULL )
+        {
+            ( void ) __atomic_fetch_add( &ulEventsDropped, 1U, __ATOMIC_RELAXED );
+            return;
+        }
+    }
+
+    /* Reserve the slot before filling it in: a signal handler that records
+     * an event in between then gets the next slot instead of the same one.
+     * The timestamp is taken afterwards, so records within a buffer are not
+     * strictly in time order - the converter sorts them. */
+    ullSlot = __atomic_fetch_add( &pxBuffer->ullHead, 1U, __ATOMIC_RELAXED );
+    pxRecord = &pxBuffer->xRecords[ ullSlot & traceBUFFER_INDEX_MASK ];
+
+    pxRecord->ullTimestamp = prvGetTimestamp();
+    pxRecord->ullObject = ( uint64_t ) ( uintptr_t ) pvObject;
+    pxRecord->ullValue = ullValue;
+    pxRecord->ulEvent = ulEvent;
+    pxRecord->ulReserved = 0;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderNameObject( const void * pvObject,
+                               eTraceObjectType eType,
+                               const char * pcName )
+{
+    TraceObjectName_t * pxName;
+    uint32_t ulIndex;
+
+    ulIndex = __atomic_fetch_add( &ulObjectsClaimed, 1U, __ATOMIC_RELAXED );
+
+    if( ulIndex < configTRACE_RECORDER_MAX_OBJECTS )
+    {
+        pxName = &xObjectNames[ ulIndex ];
+        pxName->ullTimestamp = prvGetTimestamp();
+        pxName->ullObject = ( uint64_t ) ( uintptr_t ) pvObject;
+        pxName->ulType = ( uint32_t ) eType;
+
+        if( pcName != NULL )
+        {
+            strncpy( pxName->cName, pcName, traceRECORDER_NAME_LENGTH - 1U );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvWriteAll( int iFile,
+                        const void * pvData,
+                        size_t xLength )
+{
+    const char * pcData = ( const char * ) pvData;
+    ssize_t xWritten;
+
+    while( xLength > 0U )
+    {
+        xWritten = write( iFile, pcData, xLength );
+
+        if( xWritten <= 0 )
+        {
+            return -1;
+        }
+
+        pcData += xWritten;
+        xLength -= ( size_t ) xWritten;
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+int iTraceRecorderDump( const char * pcFileName )
+{
+    TraceFileHeader_t xHeader;
+    TraceBufferHeader_t xBufferHeader;
+    const TraceBuffer_t * pxBuffer;
+    uint64_t ullHead, ullFirst, ullCount, ullStart, ullChunk;
+    uint32_t ulBuffer;
+    int iFile, iResult = 0;
+
+    /* Only async-signal-safe calls from here on, this runs from the SIGUSR2
+     * handler.  Buffers keep being written while they are copied, so the
+     * oldest records of a buffer that wraps during the dump may be newer than
+     * the header says. */
+    iFile = open( pcFileName, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+    if( iFile < 0 )
+    {
+        return -1;
+    }
+
+    memcpy( xHeader.cMagic, traceRECORDER_MAGIC, sizeof( xHeader.cMagic ) );
+    xHeader.ulRecordSize = ( uint32_t ) sizeof( TraceRecord_t );
+    xHeader.ulObjectCount = prvClampedCount( &ulObjectsClaimed, configTRACE_RECORDER_MAX_OBJECTS );
+    xHeader.ulBufferCount = prvClampedCount( &ulBuffersClaimed, configTRACE_RECORDER_MAX_THREADS );
+    xHeader.ulDropped = __atomic_load_n( &ulEventsDropped, __ATOMIC_RELAXED );
+    xHeader.ullFirstTicks = ullFirstTicks;
+    xHeader.ullFirstNs = ullFirstNs;
+    xHeader.ullLastNs = prvGetTimeNs();
+    xHeader.ullLastTicks = prvGetTimestamp();
+
+    iResult |= prvWriteAll( iFile, &xHeader, sizeof( xHeader ) );
+    iResult |= prvWriteAll( iFile, xObjectNames, xHeader.ulObjectCount * sizeof( TraceObjectName_t ) );
+
+    for( ulBuffer = 0; ulBuffer < xHeader.ulBufferCount; ulBuffer++ )
+    {
+        pxBuffer = &xBuffers[ ulBuffer ];
+        ullHead = __atomic_load_n( &pxBuffer->ullHead, __ATOMIC_ACQUIRE );
+        ullCount = ( ullHead < configTRACE_RECORDER_BUFFER_RECORDS ) ? ullHead : configTRACE_RECORDER_BUFFER_RECORDS;
+        ullFirst = ullHead - ullCount;
+
+        xBufferHeader.ulThreadId = pxBuffer->ulThreadId;
+        xBufferHeader.ulRecords = ( uint32_t ) ullCount;
+        xBufferHeader.ullOverwritten = ullFirst;
+        iResult |= prvWriteAll( iFile, &xBufferHeader, sizeof( xBufferHeader ) );
+
+        /* Oldest first, in at most two pieces when the ring has wrapped. */
+        ullStart = ullFirst & traceBUFFER_INDEX_MASK;
+        ullChunk = configTRACE_RECORDER_BUFFER_RECORDS - ullStart;
+        ullChunk = ( ullChunk < ullCount ) ? ullChunk : ullCount;
+        iResult |= prvWriteAll( iFile, &pxBuffer->xRecords[ ullStart ], ullChunk * sizeof( TraceRecord_t ) );
+        iResult |= prvWriteAll( iFile, &pxBuffer->xRecords[ 0 ], ( ullCount - ullChunk ) * sizeof( TraceRecord_t ) );
+    }
+
+    ( void ) close( iFile );
+
+    return iResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDumpAtExit( void )
+{
+    ( void ) iTraceRecorderDump( pcDumpFileName );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDumpOnSignal( int iSignal )
+{
+    int iSavedErrno = errno;
+
+    ( void ) iSignal;
+    ( void ) iTraceRecorderDump( pcDumpFileName );
+
+    errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( void )
+{
+    struct sigaction xAction;
+    static int iStarted = 0;
+
+    /* Recording works without this, it only arranges for the dump.  Called
+     * from vTaskStartScheduler(), possibly more than once. */
+    if( iStarted != 0 )
+    {
+        return;
+    }
+
+    iStarted = 1;
+    pcDumpFileName = getenv( "FREERTOS_TRACE" );
+
+    if( pcDumpFileName != NULL )
+    {
+        ( void ) atexit( prvDumpAtExit );
+    }
+    else
+    {
+        pcDumpFileName = "freertos_trace.bin";
+    }
+
+    memset( &xAction, 0, sizeof( xAction ) );
+    xAction.sa_handler = prvDumpOnSignal;
+    xAction.sa_flags = SA_RESTART;
+
+    /* Keep the tick from switching this thread out half way through. */
+    sigfillset( &xAction.sa_mask );
+    ( void ) sigaction( SIGUSR2, &xAction, NULL );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,249 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Binary kernel trace recorder for the POSIX port.
+ *
+ * Every trace macro below appends one fixed size, timestamped record to a
+ * ring buffer owned by the calling host thread.  Each buffer has a single
+ * writer (the thread itself, or a signal handler running on it), so the only
+ * synchronisation needed is an atomic increment of the buffer's head, which
+ * also keeps a record written from the tick signal handler from clobbering
+ * one the interrupted thread was half way through.  When a buffer wraps the
+ * oldest records are overwritten.
+ *
+ * The buffers are written to a file by iTraceRecorderDump(), which is called
+ * at exit when the FREERTOS_TRACE environment variable names a file, and
+ * whenever the process receives SIGUSR2 (to the same file, or to
+ * freertos_trace.bin when the variable is not set).  tools/trace2json.c
+ * converts the file to Chrome trace / Perfetto JSON.
+ *
+ * Include this header at the end of FreeRTOSConfig.h so the macros take
+ * precedence over the empty defaults in FreeRTOS.h.
+ */
+
+#ifndef TRACE_RECORDER_H_
+#define TRACE_RECORDER_H_
+
+#include <stdint.h>
+
+/* Number of records in each per-thread ring buffer, must be a power of 2. */
+#ifndef configTRACE_RECORDER_BUFFER_RECORDS
+    #define configTRACE_RECORDER_BUFFER_RECORDS    8192U
+#endif
+
+/* Number of host threads that can own a buffer.  Events from threads started
+ * after the pool is exhausted are counted as dropped. */
+#ifndef configTRACE_RECORDER_MAX_THREADS
+    #define configTRACE_RECORDER_MAX_THREADS       64U
+#endif
+
+/* Number of tasks and registered queues whose names are kept for the
+ * converter. */
+#ifndef configTRACE_RECORDER_MAX_OBJECTS
+    #define configTRACE_RECORDER_MAX_OBJECTS       256U
+#endif
+
+#if ( ( configTRACE_RECORDER_BUFFER_RECORDS & ( configTRACE_RECORDER_BUFFER_RECORDS - 1U ) ) != 0U )
+    #error configTRACE_RECORDER_BUFFER_RECORDS must be a power of 2
+#endif
+
+#define traceRECORDER_MAGIC            "FRTRACE1"
+#define traceRECORDER_NAME_LENGTH      20U
+
+/* Event identifiers.  The values are part of the file format, append new
+ * events at the end. */
+typedef enum
+{
+    eTraceEventNone = 0,
+    eTraceEventTaskSwitchedIn,      /* Object: TCB, value: priority. */
+    eTraceEventTaskSwitchedOut,     /* Object: TCB. */
+    eTraceEventTaskReady,           /* Object: TCB, value: priority. */
+    eTraceEventTaskCreate,          /* Object: TCB, value: priority. */
+    eTraceEventTaskDelete,          /* Object: TCB. */
+    eTraceEventTaskDelay,           /* Object: TCB, value: ticks. */
+    eTraceEventTaskDelayUntil,      /* Object: TCB, value: wake time. */
+    eTraceEventTaskSuspend,         /* Object: TCB. */
+    eTraceEventTaskResume,          /* Object: TCB. */
+    eTraceEventTaskPrioritySet,     /* Object: TCB, value: new priority. */
+    eTraceEventPriorityInherit,     /* Object: mutex holder TCB, value: priority. */
+    eTraceEventPriorityDisinherit,  /* Object: mutex holder TCB, value: priority. */
+    eTraceEventTick,                /* Value: tick count. */
+    eTraceEventQueueSend,           /* Object: queue, value: items before send. */
+    eTraceEventQueueSendFailed,     /* Object: queue. */
+    eTraceEventQueueReceive,        /* Object: queue, value: items before receive. */
+    eTraceEventQueueReceiveFailed,  /* Object: queue. */
+    eTraceEventQueueBlockSend,      /* Object: queue. */
+    eTraceEventQueueBlockReceive,   /* Object: queue (also peek). */
+    eTraceEventQueueSendFromISR,    /* Object: queue. */
+    eTraceEventQueueReceiveFromISR, /* Object: queue. */
+    eTraceEventNotify,              /* Object: notified TCB, value: index. */
+    eTraceEventNotifyFromISR,       /* Object: notified TCB, value: index. */
+    eTraceEventNotifyBlock,         /* Value: index. */
+    eTraceEventEventGroupSetBits,   /* Object: event group, value: bits set. */
+    eTraceEventEventGroupBlock,     /* Object: event group, value: bits waited for. */
+    eTraceEventStreamSend,          /* Object: stream buffer, value: bytes. */
+    eTraceEventStreamReceive,       /* Object: stream buffer, value: bytes. */
+    eTraceEventStreamBlockSend,     /* Object: stream buffer. */
+    eTraceEventStreamBlockReceive,  /* Object: stream buffer. */
+    eTraceEventSpscSend,            /* Object: SPSC queue. */
+    eTraceEventSpscReceive,         /* Object: SPSC queue. */
+    eTraceEventSpscBlockSend,       /* Object: SPSC queue. */
+    eTraceEventSpscBlockReceive,    /* Object: SPSC queue. */
+    eTraceEventTimerExpired,        /* Object: timer. */
+    eTraceEventCount
+} eTraceEvent;
+
+typedef enum
+{
+    eTraceObjectTask = 0,
+    eTraceObjectQueue
+} eTraceObjectType;
+
+/* One trace record, 32 bytes so two fit in a cache line. */
+typedef struct xTRACE_RECORD
+{
+    uint64_t ullTimestamp; /* Raw clock ticks, see TraceFileHeader_t. */
+    uint64_t ullObject;    /* Address of the kernel object the event is about. */
+    uint64_t ullValue;     /* Event specific, see eTraceEvent. */
+    uint32_t ulEvent;      /* eTraceEvent. */
+    uint32_t ulReserved;
+} TraceRecord_t;
+
+/* Name of a task or registered queue.  Addresses can be reused once an
+ * object is deleted, so a name applies from its timestamp onwards. */
+typedef struct xTRACE_OBJECT_NAME
+{
+    uint64_t ullTimestamp;
+    uint64_t ullObject;
+    uint32_t ulType; /* eTraceObjectType. */
+    char cName[ traceRECORDER_NAME_LENGTH ];
+} TraceObjectName_t;
+
+/* File layout: TraceFileHeader_t, ulObjectCount TraceObjectName_t, then for
+ * each of ulBufferCount buffers a TraceBufferHeader_t followed by ulRecords
+ * records in the order they were written. */
+typedef struct xTRACE_FILE_HEADER
+{
+    char cMagic[ 8 ];
+    uint32_t ulRecordSize;
+    uint32_t ulObjectCount;
+    uint32_t ulBufferCount;
+    uint32_t ulDropped;      /* Events lost because the thread pool was exhausted. */
+
+    /* Timestamps are raw clock ticks: the TSC on x86-64, where reading it is
+     * several times cheaper than clock_gettime(), and CLOCK_MONOTONIC
+     * nanoseconds elsewhere.  Two (ticks, CLOCK_MONOTONIC ns) pairs, taken
+     * when the first buffer was claimed and when the file was written, give
+     * the conversion to nanoseconds. */
+    uint64_t ullFirstTicks;
+    uint64_t ullFirstNs;
+    uint64_t ullLastTicks;
+    uint64_t ullLastNs;
+} TraceFileHeader_t;
+
+typedef struct xTRACE_BUFFER_HEADER
+{
+    uint32_t ulThreadId;
+    uint32_t ulRecords;
+    uint64_t ullOverwritten; /* Records lost to wrap around. */
+} TraceBufferHeader_t;
+
+void vTraceRecorderStart( void );
+void vTraceRecord( uint32_t ulEvent,
+                   const volatile void * pvObject,
+                   uint64_t ullValue );
+void vTraceRecorderNameObject( const void * pvObject,
+                               eTraceObjectType eType,
+                               const char * pcName );
+int iTraceRecorderDump( const char * pcFileName );
+
+#define traceRECORD( eEvent, pvObject, xValue )    vTraceRecord( ( uint32_t ) ( eEvent ), ( pvObject ), ( uint64_t ) ( xValue ) )
+
+/* *INDENT-OFF* */
+#define traceSTARTING_SCHEDULER( xIdleTaskHandles )                  vTraceRecorderStart()
+
+#define traceTASK_SWITCHED_IN()                                      traceRECORD( eTraceEventTaskSwitchedIn, pxCurrentTCB, pxCurrentTCB->uxPriority )
+#define traceTASK_SWITCHED_OUT()                                     traceRECORD( eTraceEventTaskSwitchedOut, pxCurrentTCB, 0 )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )                      traceRECORD( eTraceEventTaskReady, pxTCB, ( pxTCB )->uxPriority )
+#define traceTASK_CREATE( pxNewTCB )                                                          \
+    do {                                                                                      \
+        vTraceRecorderNameObject( ( pxNewTCB ), eTraceObjectTask, ( pxNewTCB )->pcTaskName ); \
+        traceRECORD( eTraceEventTaskCreate, pxNewTCB, ( pxNewTCB )->uxPriority );             \
+    } while( 0 )
+#define traceTASK_DELETE( pxTaskToDelete )                           traceRECORD( eTraceEventTaskDelete, pxTaskToDelete, 0 )
+#define traceTASK_DELAY()                                            traceRECORD( eTraceEventTaskDelay, pxCurrentTCB, xTicksToDelay )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )                         traceRECORD( eTraceEventTaskDelayUntil, pxCurrentTCB, xTimeToWake )
+#define traceTASK_SUSPEND( pxTaskToSuspend )                         traceRECORD( eTraceEventTaskSuspend, pxTaskToSuspend, 0 )
+#define traceTASK_RESUME( pxTaskToResume )                           traceRECORD( eTraceEventTaskResume, pxTaskToResume, 0 )
+#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )                  traceRECORD( eTraceEventTaskResume, pxTaskToResume, 0 )
+#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )              traceRECORD( eTraceEventTaskPrioritySet, pxTask, uxNewPriority )
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxPriority ) traceRECORD( eTraceEventPriorityInherit, pxTCBOfMutexHolder, uxPriority )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxPriority ) \
+    traceRECORD( eTraceEventPriorityDisinherit, pxTCBOfMutexHolder, uxPriority )
+#define traceTASK_INCREMENT_TICK( xTickCount )                       traceRECORD( eTraceEventTick, NULL, ( xTickCount ) + 1U )
+
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )               vTraceRecorderNameObject( ( xQueue ), eTraceObjectQueue, ( pcQueueName ) )
+#define traceQUEUE_SEND( pxQueue )                                   traceRECORD( eTraceEventQueueSend, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )                            traceRECORD( eTraceEventQueueSendFailed, pxQueue, 0 )
+#define traceQUEUE_RECEIVE( pxQueue )                                traceRECORD( eTraceEventQueueReceive, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )                         traceRECORD( eTraceEventQueueReceiveFailed, pxQueue, 0 )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )                       traceRECORD( eTraceEventQueueBlockSend, pxQueue, 0 )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )                    traceRECORD( eTraceEventQueueBlockReceive, pxQueue, 0 )
+#define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )                       traceRECORD( eTraceEventQueueBlockReceive, pxQueue, 0 )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )                          traceRECORD( eTraceEventQueueSendFromISR, pxQueue, 0 )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )                       traceRECORD( eTraceEventQueueReceiveFromISR, pxQueue, 0 )
+
+#define traceTASK_NOTIFY( uxIndexToNotify )                          traceRECORD( eTraceEventNotify, pxTCB, uxIndexToNotify )
+#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )                 traceRECORD( eTraceEventNotifyFromISR, pxTCB, uxIndexToNotify )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )            traceRECORD( eTraceEventNotifyFromISR, pxTCB, uxIndexToNotify )
+#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )                 traceRECORD( eTraceEventNotifyBlock, pxCurrentTCB, uxIndexToWait )
+#define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )                 traceRECORD( eTraceEventNotifyBlock, pxCurrentTCB, uxIndexToWait )
+
+#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )        traceRECORD( eTraceEventEventGroupSetBits, xEventGroup, uxBitsToSet )
+#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet ) \
+    traceRECORD( eTraceEventEventGroupSetBits, xEventGroup, uxBitsToSet )
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor ) \
+    traceRECORD( eTraceEventEventGroupBlock, xEventGroup, uxBitsToWaitFor )
+#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor ) \
+    traceRECORD( eTraceEventEventGroupBlock, xEventGroup, uxBitsToWaitFor )
+
+#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )         traceRECORD( eTraceEventStreamSend, xStreamBuffer, xBytesSent )
+#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength ) traceRECORD( eTraceEventStreamReceive, xStreamBuffer, xReceivedLength )
+#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )         traceRECORD( eTraceEventStreamBlockSend, xStreamBuffer, 0 )
+#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )      traceRECORD( eTraceEventStreamBlockReceive, xStreamBuffer, 0 )
+
+#define traceSPSC_QUEUE_SEND( xQueue )                               traceRECORD( eTraceEventSpscSend, xQueue, 0 )
+#define traceSPSC_QUEUE_RECEIVE( xQueue )                            traceRECORD( eTraceEventSpscReceive, xQueue, 0 )
+#define traceBLOCKING_ON_SPSC_QUEUE_SEND( xQueue )                   traceRECORD( eTraceEventSpscBlockSend, xQueue, 0 )
+#define traceBLOCKING_ON_SPSC_QUEUE_RECEIVE( xQueue )                traceRECORD( eTraceEventSpscBlockReceive, xQueue, 0 )
+
+#define traceTIMER_EXPIRED( pxTimer )                                traceRECORD( eTraceEventTimerExpired, pxTimer, 0 )
+/* *INDENT-ON* */
+
+#endif /* ifndef TRACE_RECORDER_H_ */
@@ -137,3 +137,9 @@ void event_signal( struct event * ev )
     pthread_mutex_unlock( &ev->mutex );
 }
 /*-----------------------------------------------------------*/
+
+size_t event_size( void )
+{
+    return sizeof( struct event );
+}
+/*-----------------------------------------------------------*/
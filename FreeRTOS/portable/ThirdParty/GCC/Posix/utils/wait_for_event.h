@@ -30,6 +30,7 @@
 #define WAIT_FOR_EVENT_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <time.h>
 
 struct event;
@@ -40,6 +41,7 @@ bool event_wait( struct event * ev );
 bool event_wait_timed( struct event * ev,
                        time_t ms );
 void event_signal( struct event * ev );
+size_t event_size( void );
 
 
 
@@ -54,7 +54,13 @@
     typedef struct EventGroupDef_t
     {
         EventBits_t uxEventBits;
-        List_t xTasksWaitingForBits; /**< List of tasks waiting for a bit to be set. */
+
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+            List_t xTasksWaitingForBits[ eventNUMBER_OF_EVENT_BITS ];    /**< Tasks waiting for bits, indexed by the lowest bit each task waits for. */
+            EventBits_t uxBitsWaitedFor[ eventNUMBER_OF_EVENT_BITS ];    /**< For each list, a superset of the bits its tasks wait for. */
+        #else
+            List_t xTasksWaitingForBits; /**< List of tasks waiting for a bit to be set. */
+        #endif
 
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxEventGroupNumber;
@@ -79,6 +85,26 @@
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the list(s) of tasks waiting for bits in a new event group.
+ */
+    static void prvInitialiseWaiterLists( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the list a task waiting for uxBitsToWaitFor is to be placed on.
+ */
+    static List_t * prvGetWaiterList( EventGroup_t * pxEventBits,
+                                      const EventBits_t uxBitsToWaitFor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the tasks in pxList whose wait condition is met by the current event
+ * bits, accumulating the bits they want cleared on exit in *puxBitsToClear.
+ * Returns the bits waited for by the tasks that remain in the list.
+ */
+    static EventBits_t prvUnblockWaiters( EventGroup_t * pxEventBits,
+                                          List_t * pxList,
+                                          EventBits_t * puxBitsToClear ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------*/
 
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -111,7 +137,7 @@
             if( pxEventBits != NULL )
             {
                 pxEventBits->uxEventBits = 0;
-                vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+                prvInitialiseWaiterLists( pxEventBits );
 
                 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
@@ -156,7 +182,7 @@
             if( pxEventBits != NULL )
             {
                 pxEventBits->uxEventBits = 0;
-                vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+                prvInitialiseWaiterLists( pxEventBits );
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -228,7 +254,7 @@
                     /* Store the bits that the calling task is waiting for in the
                      * task's event list item so the kernel knows when a match is
                      * found.  Then enter the blocked state. */
-                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    vTaskPlaceOnUnorderedEventList( prvGetWaiterList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                     /* This assignment is obsolete as uxReturn will get set after
                      * the task unblocks, but some compilers mistakenly generate a
@@ -391,7 +417,7 @@
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( prvGetWaiterList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
                 /* This is obsolete as it will get set after the task unblocks, but
                  * some compilers mistakenly generate a warning about the variable
@@ -547,13 +573,8 @@
     EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                     const EventBits_t uxBitsToSet )
     {
-        ListItem_t * pxListItem;
-        ListItem_t * pxNext;
-        ListItem_t const * pxListEnd;
-        List_t const * pxList;
-        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxReturnBits;
+        EventBits_t uxBitsToClear = 0, uxReturnBits;
         EventGroup_t * pxEventBits = xEventGroup;
-        BaseType_t xMatchFound = pdFALSE;
 
         traceENTER_xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
@@ -562,75 +583,39 @@
         configASSERT( xEventGroup );
         configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-        pxList = &( pxEventBits->xTasksWaitingForBits );
-        pxListEnd = listGET_END_MARKER( pxList );
         vTaskSuspendAll();
         {
             traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-            pxListItem = listGET_HEAD_ENTRY( pxList );
-
             /* Set the bits. */
             pxEventBits->uxEventBits |= uxBitsToSet;
 
             /* See if the new bit value should unblock any tasks. */
-            while( pxListItem != pxListEnd )
+            #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
             {
-                pxNext = listGET_NEXT( pxListItem );
-                uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-                xMatchFound = pdFALSE;
-
-                /* Split the bits waited for from the control bits. */
-                uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-                uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-                if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-                {
-                    /* Just looking for single bit being set. */
-                    if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                    {
-                        xMatchFound = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-                {
-                    /* All bits are set. */
-                    xMatchFound = pdTRUE;
-                }
-                else
-                {
-                    /* Need all bits to be set, but not all the bits were set. */
-                }
+                size_t x;
 
-                if( xMatchFound != pdFALSE )
+                /* A blocked task's wait condition was not met when it blocked,
+                 * and every later set re-tested it, so it can only be met now if
+                 * one of the bits it waits for is in uxBitsToSet.  Only the lists
+                 * holding such a task need to be examined. */
+                for( x = 0; x < eventNUMBER_OF_EVENT_BITS; x++ )
                 {
-                    /* The bits match.  Should the bits be cleared on exit? */
-                    if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                    if( ( pxEventBits->uxBitsWaitedFor[ x ] & uxBitsToSet ) != ( EventBits_t ) 0 )
                     {
-                        uxBitsToClear |= uxBitsWaitedFor;
+                        pxEventBits->uxBitsWaitedFor[ x ] = prvUnblockWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBits[ x ] ), &uxBitsToClear );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* Store the actual event flag value in the task's event list
-                     * item before removing the task from the event list.  The
-                     * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                     * that is was unblocked due to its required bits matching, rather
-                     * than because it timed out. */
-                    vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
                 }
-
-                /* Move onto the next list item.  Note pxListItem->pxNext is not
-                 * used here as the list item may have been removed from the event list
-                 * and inserted into the ready/pending reading list. */
-                pxListItem = pxNext;
             }
+            #else /* if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) */
+            {
+                ( void ) prvUnblockWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear );
+            }
+            #endif /* if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) */
 
             /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
              * bit was set in the control word. */
@@ -647,27 +632,115 @@
     }
 /*-----------------------------------------------------------*/
 
+    static EventBits_t prvUnblockWaiters( EventGroup_t * pxEventBits,
+                                          List_t * pxList,
+                                          EventBits_t * puxBitsToClear )
+    {
+        ListItem_t * pxListItem;
+        ListItem_t * pxNext;
+        ListItem_t const * pxListEnd;
+        EventBits_t uxBitsWaitedFor, uxControlBits;
+        EventBits_t uxBitsStillWaitedFor = 0;
+        BaseType_t xMatchFound;
+
+        pxListEnd = listGET_END_MARKER( pxList );
+        pxListItem = listGET_HEAD_ENTRY( pxList );
+
+        while( pxListItem != pxListEnd )
+        {
+            pxNext = listGET_NEXT( pxListItem );
+            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+            xMatchFound = pdFALSE;
+
+            /* Split the bits waited for from the control bits. */
+            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+            {
+                /* Just looking for single bit being set. */
+                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                {
+                    xMatchFound = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+            {
+                /* All bits are set. */
+                xMatchFound = pdTRUE;
+            }
+            else
+            {
+                /* Need all bits to be set, but not all the bits were set. */
+            }
+
+            if( xMatchFound != pdFALSE )
+            {
+                /* The bits match.  Should the bits be cleared on exit? */
+                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                {
+                    *puxBitsToClear |= uxBitsWaitedFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Store the actual event flag value in the task's event list
+                 * item before removing the task from the event list.  The
+                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+                 * that is was unblocked due to its required bits matching, rather
+                 * than because it timed out. */
+                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+            }
+            else
+            {
+                uxBitsStillWaitedFor |= uxBitsWaitedFor;
+            }
+
+            /* Move onto the next list item.  Note pxListItem->pxNext is not
+             * used here as the list item may have been removed from the event list
+             * and inserted into the ready/pending reading list. */
+            pxListItem = pxNext;
+        }
+
+        return uxBitsStillWaitedFor;
+    }
+/*-----------------------------------------------------------*/
+
     void vEventGroupDelete( EventGroupHandle_t xEventGroup )
     {
         EventGroup_t * pxEventBits = xEventGroup;
         const List_t * pxTasksWaitingForBits;
+        size_t x;
 
         traceENTER_vEventGroupDelete( xEventGroup );
 
         configASSERT( pxEventBits );
 
-        pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
-
         vTaskSuspendAll();
         {
             traceEVENT_GROUP_DELETE( xEventGroup );
 
-            while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+            for( x = 0; x < ( sizeof( pxEventBits->xTasksWaitingForBits ) / sizeof( List_t ) ); x++ )
             {
-                /* Unblock the task, returning 0 as the event list is being deleted
-                 * and cannot therefore have any bits set. */
-                configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-                vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits[ x ] );
+                #else
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+                #endif
+
+                while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                {
+                    /* Unblock the task, returning 0 as the event list is being deleted
+                     * and cannot therefore have any bits set. */
+                    configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+                    vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
             }
         }
         ( void ) xTaskResumeAll();
@@ -812,6 +885,61 @@
     }
 /*-----------------------------------------------------------*/
 
+    static void prvInitialiseWaiterLists( EventGroup_t * pxEventBits )
+    {
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        {
+            size_t x;
+
+            for( x = 0; x < eventNUMBER_OF_EVENT_BITS; x++ )
+            {
+                vListInitialise( &( pxEventBits->xTasksWaitingForBits[ x ] ) );
+                pxEventBits->uxBitsWaitedFor[ x ] = 0;
+            }
+        }
+        #else
+        {
+            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+        }
+        #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+    }
+/*-----------------------------------------------------------*/
+
+    static List_t * prvGetWaiterList( EventGroup_t * pxEventBits,
+                                      const EventBits_t uxBitsToWaitFor )
+    {
+        List_t * pxList;
+
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        {
+            size_t x = 0;
+
+            /* Use the list of the lowest bit waited for.  Bits that are not the
+             * lowest are covered by the list's uxBitsWaitedFor summary, which is
+             * only ever a superset: it is recomputed when xEventGroupSetBits()
+             * walks the list, so tasks leaving the list for other reasons just
+             * cause an occasional unnecessary walk. */
+            while( ( uxBitsToWaitFor & ( ( EventBits_t ) 1 << x ) ) == ( EventBits_t ) 0 )
+            {
+                x++;
+            }
+
+            configASSERT( x < eventNUMBER_OF_EVENT_BITS );
+
+            pxEventBits->uxBitsWaitedFor[ x ] |= uxBitsToWaitFor;
+            pxList = &( pxEventBits->xTasksWaitingForBits[ x ] );
+        }
+        #else
+        {
+            ( void ) uxBitsToWaitFor;
+            pxList = &( pxEventBits->xTasksWaitingForBits );
+        }
+        #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+
+        return pxList;
+    }
+/*-----------------------------------------------------------*/
+
     #if ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
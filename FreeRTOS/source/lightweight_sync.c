@@ -0,0 +1,679 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "lightweight_sync.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include lightweight semaphores and events. This #if is closed at the very
+ * bottom of this file. If you want to include them then ensure
+ * configUSE_LIGHTWEIGHT_SYNC is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build lightweight_sync.c
+    #endif
+
+    #if ( configUSE_COUNTING_SEMAPHORES != 1 )
+        #error configUSE_COUNTING_SEMAPHORES must be set to 1 to build lightweight_sync.c
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build lightweight_sync.c
+    #endif
+
+    #if ( INCLUDE_uxTaskPriorityGet != 1 )
+        #error INCLUDE_uxTaskPriorityGet must be set to 1 to build lightweight_sync.c
+    #endif
+
+/* Bits stored in the ucFlags field of the object. */
+    #define lightsyncFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the object was created using statically allocated memory. */
+
+/*lint -save -e9058 Same struct definition across two files is not a MISRA violation. */
+
+/* Structure that holds state information on a lightweight semaphore or event.
+ * Every field other than xFallbackBuffer is only accessed from within a
+ * critical section once the object has been created. */
+typedef struct LightSyncDef_t
+{
+    volatile UBaseType_t uxCount;            /* Semaphore: the count.  Event: non-zero once set. */
+    UBaseType_t uxMaxCount;                  /* The count a give is refused at. */
+    TaskHandle_t volatile xWaitingTask;      /* Holds the handle of the task waiting on a notification, or NULL. */
+    SemaphoreHandle_t xFallback;             /* Tasks beyond the first block on this semaphore. */
+    UBaseType_t uxFallbackWaiters;           /* The number of tasks blocked, or about to block, on xFallback. */
+    UBaseType_t uxNotificationIndex;         /* The index xWaitingTask waits on, by default tskDEFAULT_INDEX_TO_NOTIFY. */
+    uint8_t ucSyncType;                      /* lightsyncTYPE_SEMAPHORE or lightsyncTYPE_EVENT. */
+    uint8_t ucFlags;
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        StaticSemaphore_t xFallbackBuffer;   /* Holds xFallback, so creating the object is a single allocation. */
+    #endif
+} LightSync_t;
+
+/*
+ * Gives a semaphore or sets an event.  Called from within a critical section
+ * by tasks and interrupts alike, so it only uses the FromISR API functions:
+ * nothing it unblocks can run until every waiter it owes has been released.
+ * *pxHigherPriorityTaskWoken is set if the caller should yield.
+ */
+static BaseType_t prvSignal( LightSync_t * const pxSync,
+                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task on the fallback semaphore, for when another task is
+ * already waiting on the object.
+ */
+static BaseType_t prvWaitOnFallback( LightSync_t * const pxSync,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both create functions to initialise the object.  Returns pdFAIL if
+ * the fallback semaphore could not be created.
+ */
+static BaseType_t prvInitialiseNewLightSync( LightSync_t * const pxSync,
+                                             UBaseType_t uxMaxCount,
+                                             UBaseType_t uxInitialCount,
+                                             uint8_t ucSyncType,
+                                             uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    LightSyncHandle_t xLightSyncGenericCreate( UBaseType_t uxMaxCount,
+                                               UBaseType_t uxInitialCount,
+                                               uint8_t ucSyncType )
+    {
+        LightSync_t * pxNewSync;
+
+        traceENTER_xLightSyncGenericCreate( uxMaxCount, uxInitialCount, ucSyncType );
+
+        configASSERT( uxMaxCount > ( UBaseType_t ) 0 );
+        configASSERT( uxInitialCount <= uxMaxCount );
+        configASSERT( ( ucSyncType == lightsyncTYPE_SEMAPHORE ) || ( ucSyncType == lightsyncTYPE_EVENT ) );
+
+        /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxNewSync = ( LightSync_t * ) pvPortMalloc( sizeof( LightSync_t ) );
+
+        if( pxNewSync != NULL )
+        {
+            if( prvInitialiseNewLightSync( pxNewSync, uxMaxCount, uxInitialCount, ucSyncType, ( uint8_t ) 0 ) == pdFAIL )
+            {
+                vPortFree( pxNewSync );
+                pxNewSync = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xLightSyncGenericCreate( pxNewSync );
+
+        return pxNewSync;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    LightSyncHandle_t xLightSyncGenericCreateStatic( UBaseType_t uxMaxCount,
+                                                     UBaseType_t uxInitialCount,
+                                                     uint8_t ucSyncType,
+                                                     StaticLightSync_t * const pxStaticSync )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        LightSync_t * const pxSync = ( LightSync_t * ) pxStaticSync;
+        LightSyncHandle_t xReturn = NULL;
+
+        traceENTER_xLightSyncGenericCreateStatic( uxMaxCount, uxInitialCount, ucSyncType, pxStaticSync );
+
+        configASSERT( pxStaticSync );
+        configASSERT( uxMaxCount > ( UBaseType_t ) 0 );
+        configASSERT( uxInitialCount <= uxMaxCount );
+        configASSERT( ( ucSyncType == lightsyncTYPE_SEMAPHORE ) || ( ucSyncType == lightsyncTYPE_EVENT ) );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticLightSync_t equals the size of the real
+             * structure. */
+            volatile size_t xSize = sizeof( StaticLightSync_t );
+            configASSERT( xSize == sizeof( LightSync_t ) );
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( pxStaticSync != NULL )
+        {
+            /* The fallback semaphore lives in pxStaticSync, so this cannot
+             * fail. */
+            ( void ) prvInitialiseNewLightSync( pxSync, uxMaxCount, uxInitialCount, ucSyncType, lightsyncFLAGS_IS_STATICALLY_ALLOCATED );
+            xReturn = pxSync;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xLightSyncGenericCreateStatic( xReturn );
+
+        return xReturn;
+    }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vLightSyncDelete( LightSyncHandle_t xSync )
+{
+    LightSync_t * pxSync = xSync;
+
+    traceENTER_vLightSyncDelete( xSync );
+
+    configASSERT( pxSync );
+    configASSERT( pxSync->xWaitingTask == NULL );
+    configASSERT( pxSync->uxFallbackWaiters == ( UBaseType_t ) 0 );
+
+    vSemaphoreDelete( pxSync->xFallback );
+
+    if( ( pxSync->ucFlags & lightsyncFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( ( void * ) pxSync );
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xSync == ( LightSyncHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure was statically allocated, so there is nothing to
+         * free.  Clear it so it is obviously stale. */
+        ( void ) memset( pxSync, 0x00, sizeof( LightSync_t ) );
+    }
+
+    traceRETURN_vLightSyncDelete();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightSyncWait( LightSyncHandle_t xSync,
+                           TickType_t xTicksToWait )
+{
+    LightSync_t * const pxSync = xSync;
+    const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    BaseType_t xReturn = pdFAIL;
+    BaseType_t xIsWaiting = pdFALSE;
+    BaseType_t xUseFallback = pdFALSE;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    BaseType_t xTimedOut;
+    TimeOut_t xTimeOut;
+
+    traceENTER_xLightSyncWait( xSync, xTicksToWait );
+
+    configASSERT( pxSync );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( ( xIsWaiting != pdFALSE ) && ( pxTaskGetLightSyncWaiter() == NULL ) )
+            {
+                /* The kernel dropped the record because this task was
+                 * suspended, so gives went to other tasks meanwhile.  Start
+                 * again, keeping the original timeout. */
+                xIsWaiting = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xIsWaiting != pdFALSE ) && ( pxSync->xWaitingTask != xCurrentTask ) )
+            {
+                /* Otherwise only the signalling side clears the record of this
+                 * task, and it does so when it hands this task the count or
+                 * sets the event. */
+                vTaskSetLightSyncWaiter( NULL, pxSync->uxNotificationIndex );
+                xIsWaiting = pdFALSE;
+                xReturn = pdPASS;
+            }
+            else if( pxSync->uxCount > ( UBaseType_t ) 0 )
+            {
+                /* An event stays set, a semaphore is taken. */
+                if( pxSync->ucSyncType == lightsyncTYPE_SEMAPHORE )
+                {
+                    pxSync->uxCount--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                if( xIsWaiting != pdFALSE )
+                {
+                    pxSync->xWaitingTask = NULL;
+                    vTaskSetLightSyncWaiter( NULL, pxSync->uxNotificationIndex );
+                    xIsWaiting = pdFALSE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( xIsWaiting == pdFALSE )
+            {
+                if( ( pxSync->xWaitingTask == NULL ) && ( pxSync->uxFallbackWaiters == ( UBaseType_t ) 0 ) )
+                {
+                    /* The only waiter, so wait on a notification.  Drop any
+                     * notification left from an earlier wait first.  This also
+                     * drops one pending on the same index for any other
+                     * reason, which is why the index must be reserved. */
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, pxSync->uxNotificationIndex );
+                    pxSync->xWaitingTask = xCurrentTask;
+                    vTaskSetLightSyncWaiter( &( pxSync->xWaitingTask ), pxSync->uxNotificationIndex );
+                    xIsWaiting = pdTRUE;
+                }
+                else
+                {
+                    /* Contended.  Counting this task here means a signal that
+                     * arrives before it blocks on xFallback still reaches it. */
+                    pxSync->uxFallbackWaiters++;
+                    xUseFallback = pdTRUE;
+                }
+            }
+            else
+            {
+                /* Still recorded, so a timeout check or another notification
+                 * woke this task.  Keep waiting. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( xReturn != pdFAIL ) || ( xUseFallback != pdFALSE ) || ( xIsWaiting == pdFALSE ) )
+        {
+            break;
+        }
+
+        if( xEntryTimeSet == pdFALSE )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+            xEntryTimeSet = pdTRUE;
+            xTimedOut = pdFALSE;
+        }
+        else
+        {
+            /* Sets xTicksToWait to 0 if the block time has expired, so the
+             * next pass removes the record or finds it already removed. */
+            xTimedOut = xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+        }
+
+        if( xTimedOut == pdFALSE )
+        {
+            traceBLOCKING_ON_LIGHT_SYNC_WAIT( xSync );
+            ( void ) xTaskNotifyWaitIndexed( pxSync->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( xUseFallback != pdFALSE )
+    {
+        xReturn = prvWaitOnFallback( pxSync, xTicksToWait );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn != pdFAIL )
+    {
+        traceLIGHT_SYNC_WAIT( xSync );
+    }
+    else
+    {
+        traceLIGHT_SYNC_WAIT_FAILED( xSync );
+    }
+
+    traceRETURN_xLightSyncWait( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightSyncSignal( LightSyncHandle_t xSync )
+{
+    BaseType_t xReturn;
+    BaseType_t xYieldRequired = pdFALSE;
+
+    traceENTER_xLightSyncSignal( xSync );
+
+    configASSERT( xSync );
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = prvSignal( xSync, &xYieldRequired );
+    }
+    taskEXIT_CRITICAL();
+
+    #if ( configUSE_PREEMPTION == 1 )
+    {
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_PREEMPTION */
+
+    traceRETURN_xLightSyncSignal( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightSyncSignalFromISR( LightSyncHandle_t xSync,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+
+    traceENTER_xLightSyncSignalFromISR( xSync, pxHigherPriorityTaskWoken );
+
+    configASSERT( xSync );
+
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    {
+        xReturn = prvSignal( xSync, &xHigherPriorityTaskWoken );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xLightSyncSignalFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxLightSyncGetCount( LightSyncHandle_t xSync )
+{
+    const LightSync_t * const pxSync = xSync;
+    UBaseType_t uxReturn;
+
+    traceENTER_uxLightSyncGetCount( xSync );
+
+    configASSERT( pxSync );
+
+    uxReturn = pxSync->uxCount;
+
+    traceRETURN_uxLightSyncGetCount( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vLightSyncSetNotificationIndex( LightSyncHandle_t xSync,
+                                     UBaseType_t uxNotificationIndex )
+{
+    LightSync_t * const pxSync = xSync;
+
+    traceENTER_vLightSyncSetNotificationIndex( xSync, uxNotificationIndex );
+
+    configASSERT( pxSync );
+
+    /* There should be no task waiting otherwise we'd never resume it. */
+    configASSERT( pxSync->xWaitingTask == NULL );
+
+    /* Check that the task notification index is valid. */
+    configASSERT( uxNotificationIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+    pxSync->uxNotificationIndex = uxNotificationIndex;
+
+    traceRETURN_vLightSyncSetNotificationIndex();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSignal( LightSync_t * const pxSync,
+                             BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn = pdPASS;
+    TaskHandle_t xWaitingTask = pxSync->xWaitingTask;
+    UBaseType_t uxToRelease;
+    UBaseType_t uxFallbackPriority;
+
+    if( ( pxSync->ucSyncType == lightsyncTYPE_EVENT ) && ( pxSync->uxCount != ( UBaseType_t ) 0 ) )
+    {
+        /* An event is only set once. */
+        xReturn = pdFAIL;
+    }
+    else if( ( pxSync->ucSyncType == lightsyncTYPE_SEMAPHORE ) &&
+             ( pxSync->xWaitingTask == NULL ) &&
+             ( pxSync->uxFallbackWaiters == ( UBaseType_t ) 0 ) )
+    {
+        /* The fast path: nobody is waiting. */
+        if( pxSync->uxCount < pxSync->uxMaxCount )
+        {
+            pxSync->uxCount++;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+    }
+    else
+    {
+        if( pxSync->ucSyncType == lightsyncTYPE_EVENT )
+        {
+            /* Set the event and release every waiter. */
+            pxSync->uxCount = ( UBaseType_t ) 1;
+            uxToRelease = pxSync->uxFallbackWaiters;
+        }
+        else if( xWaitingTask == NULL )
+        {
+            /* Only tasks on xFallback are waiting, and it wakes them in
+             * priority order. */
+            uxToRelease = ( UBaseType_t ) 1;
+        }
+        else if( ( pxSync->uxFallbackWaiters > ( UBaseType_t ) 0 ) &&
+                 ( xQueueGetHighestReceiverPriority( pxSync->xFallback, &uxFallbackPriority ) != pdFALSE ) &&
+                 ( uxFallbackPriority > uxTaskPriorityGetFromISR( xWaitingTask ) ) )
+        {
+            /* Hand the count to the highest priority waiter.  The task waiting
+             * on a notification blocked before any task on xFallback did, so
+             * it only loses out to a task of strictly higher priority.  A
+             * task counted in uxFallbackWaiters that has not blocked yet is
+             * not considered. */
+            xWaitingTask = NULL;
+            uxToRelease = ( UBaseType_t ) 1;
+        }
+        else
+        {
+            uxToRelease = ( UBaseType_t ) 0;
+        }
+
+        if( xWaitingTask != NULL )
+        {
+            /* Clearing the record is what tells the task it was signalled;
+             * the notification only unblocks it. */
+            pxSync->xWaitingTask = NULL;
+
+            ( void ) xTaskNotifyIndexedFromISR( xWaitingTask, pxSync->uxNotificationIndex, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Each give to the fallback semaphore is owed to exactly one of the
+         * tasks counted in uxFallbackWaiters, so take them off the count. */
+        pxSync->uxFallbackWaiters -= uxToRelease;
+
+        while( uxToRelease > ( UBaseType_t ) 0 )
+        {
+            ( void ) xSemaphoreGiveFromISR( pxSync->xFallback, pxHigherPriorityTaskWoken );
+            uxToRelease--;
+        }
+    }
+
+    if( xReturn != pdFAIL )
+    {
+        traceLIGHT_SYNC_SIGNAL( pxSync );
+    }
+    else
+    {
+        traceLIGHT_SYNC_SIGNAL_FAILED( pxSync );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWaitOnFallback( LightSync_t * const pxSync,
+                                     TickType_t xTicksToWait )
+{
+    BaseType_t xReturn;
+
+    traceBLOCKING_ON_LIGHT_SYNC_FALLBACK( pxSync );
+
+    xReturn = xSemaphoreTake( pxSync->xFallback, xTicksToWait );
+
+    if( xReturn == pdFAIL )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* A signal may have been owed to this task after the take timed
+             * out.  Either collect it, or stop being counted as a waiter so
+             * later signals are not owed to this task. */
+            if( xSemaphoreTake( pxSync->xFallback, ( TickType_t ) 0 ) != pdFAIL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                pxSync->uxFallbackWaiters--;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvInitialiseNewLightSync( LightSync_t * const pxSync,
+                                             UBaseType_t uxMaxCount,
+                                             UBaseType_t uxInitialCount,
+                                             uint8_t ucSyncType,
+                                             uint8_t ucFlags )
+{
+    /* The fallback semaphore is never given more often than there are tasks
+     * waiting on it, so its maximum count is never reached. */
+    const UBaseType_t uxFallbackMaxCount = ( UBaseType_t ) ~( ( UBaseType_t ) 0 );
+
+    ( void ) memset( ( void * ) pxSync, 0x00, sizeof( LightSync_t ) );
+    pxSync->uxCount = uxInitialCount;
+    pxSync->uxMaxCount = uxMaxCount;
+    pxSync->uxNotificationIndex = tskDEFAULT_INDEX_TO_NOTIFY;
+    pxSync->ucSyncType = ucSyncType;
+    pxSync->ucFlags = ucFlags;
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    {
+        pxSync->xFallback = xSemaphoreCreateCountingStatic( uxFallbackMaxCount, ( UBaseType_t ) 0, &( pxSync->xFallbackBuffer ) );
+    }
+    #else
+    {
+        pxSync->xFallback = xSemaphoreCreateCounting( uxFallbackMaxCount, ( UBaseType_t ) 0 );
+    }
+    #endif
+
+    return ( pxSync->xFallback != NULL ) ? pdPASS : pdFAIL;
+}
+
+/* This entire source file will be skipped if the application is not configured
+ * to include lightweight semaphores and events. This #if is closed at the very
+ * bottom of this file. If you want to include them then ensure
+ * configUSE_LIGHTWEIGHT_SYNC is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_LIGHTWEIGHT_SYNC == 1 */
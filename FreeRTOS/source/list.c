@@ -157,8 +157,14 @@ void vListInsert( List_t * const pxList,
      * stored in ready lists (all of which have the same xItemValue value) get a
      * share of the CPU.  However, if the xItemValue is the same as the back marker
      * the iteration loop below will not end.  Therefore the value is checked
-     * first, and the algorithm slightly modified if necessary. */
-    if( xValueOfInsertion == portMAX_DELAY )
+     * first, and the algorithm slightly modified if necessary.
+     *
+     * The same check also covers an item that sorts at or after the last item
+     * in the list, which is then appended without searching.  This is the
+     * common case for event lists, where the tasks blocked on one object
+     * often share a priority, so many waiters do not cost a walk along the
+     * list each. */
+    if( xValueOfInsertion >= pxList->xListEnd.pxPrevious->xItemValue )
     {
         pxIterator = pxList->xListEnd.pxPrevious;
     }
@@ -213,6 +219,50 @@ void vListInsert( List_t * const pxList,
 }
 /*-----------------------------------------------------------*/
 
+void vListInsertFrom( List_t * const pxList,
+                      ListItem_t * pxStartListItem,
+                      ListItem_t * const pxNewListItem )
+{
+    ListItem_t * pxIterator;
+    const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+
+    traceENTER_vListInsertFrom( pxList, pxStartListItem, pxNewListItem );
+
+    listTEST_LIST_INTEGRITY( pxList );
+    listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
+
+    /* The starting point must be in this list and must not sort after the
+     * new item, otherwise the search would pass the correct position. */
+    configASSERT( ( pxStartListItem == ( ListItem_t * ) &( pxList->xListEnd ) ) ||
+                  ( ( pxStartListItem->pxContainer == pxList ) && ( pxStartListItem->xItemValue <= xValueOfInsertion ) ) );
+
+    /* See vListInsert() for why the last item is checked first. */
+    if( xValueOfInsertion >= pxList->xListEnd.pxPrevious->xItemValue )
+    {
+        pxIterator = pxList->xListEnd.pxPrevious;
+    }
+    else
+    {
+        for( pxIterator = pxStartListItem; pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext )
+        {
+            /* There is nothing to do here, just iterating to the wanted
+             * insertion position. */
+        }
+    }
+
+    pxNewListItem->pxNext = pxIterator->pxNext;
+    pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+    pxNewListItem->pxPrevious = pxIterator;
+    pxIterator->pxNext = pxNewListItem;
+
+    pxNewListItem->pxContainer = pxList;
+
+    ( pxList->uxNumberOfItems ) = ( UBaseType_t ) ( pxList->uxNumberOfItems + 1U );
+
+    traceRETURN_vListInsertFrom();
+}
+/*-----------------------------------------------------------*/
+
 
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 {
@@ -82,6 +82,23 @@ typedef struct SemaphoreData
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+/* Bits used in the ucZeroCopySlots member of a queue.  A reserved slot is the
+ * one pcWriteTo points to, so other items cannot be sent to the back of the
+ * queue until it is committed.  An acquired slot is the one pcReadFrom points
+ * to, so other items cannot be received, or sent to the front of the queue,
+ * until it is released.  Both count against the space in the queue. */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define queueSLOT_RESERVED                  ( 0x01U )
+    #define queueSLOT_ACQUIRED                  ( 0x02U )
+    #define queueIS_SLOT_RESERVED( pxQueue )    ( ( ( ( pxQueue )->ucZeroCopySlots & queueSLOT_RESERVED ) != 0U ) ? pdTRUE : pdFALSE )
+    #define queueIS_SLOT_ACQUIRED( pxQueue )    ( ( ( ( pxQueue )->ucZeroCopySlots & queueSLOT_ACQUIRED ) != 0U ) ? pdTRUE : pdFALSE )
+    #define queueZERO_COPY_SLOTS( pxQueue )     ( ( UBaseType_t ) queueIS_SLOT_RESERVED( pxQueue ) + ( UBaseType_t ) queueIS_SLOT_ACQUIRED( pxQueue ) )
+#else
+    #define queueIS_SLOT_RESERVED( pxQueue )    ( pdFALSE )
+    #define queueIS_SLOT_ACQUIRED( pxQueue )    ( pdFALSE )
+    #define queueZERO_COPY_SLOTS( pxQueue )     ( ( UBaseType_t ) 0U )
+#endif
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -121,18 +138,30 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
     volatile int8_t cRxLock;                /**< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
     volatile int8_t cTxLock;                /**< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucZeroCopySlots; /**< Holds bits to say if a slot has been reserved by xQueueReserve() or acquired by xQueueAcquire() and not yet committed or released. */
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
     #endif
 
     #if ( configUSE_QUEUE_SETS == 1 )
         struct QueueDefinition * pxQueueSetContainer;
+
+        #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+            UBaseType_t uxQueueSetState; /**< In a set member, pdTRUE while the set holds the member's handle.  In a set, the number of members. */
+        #endif
     #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_EVENT_LIST_INDEX == 1 )
+        EventListIndex_t xWaitingIndex[ 2 ]; /**< Priorities waiting in xTasksWaitingToSend (0) and xTasksWaitingToReceive (1), see configUSE_EVENT_LIST_INDEX. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -190,11 +219,76 @@ static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any space in a queue.
+ * As prvIsQueueEmpty(), but for xQueuePeek(), which can still read the items
+ * that remain in the queue while another item is acquired.
+ *
+ * @return pdTRUE if the queue contains no items, otherwise pdFALSE.
+ */
+static BaseType_t prvIsQueueEmptyToPeek( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Uses a critical section to determine if there is any space in a queue for an
+ * item sent to the xPosition end.
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+
+/*
+ * Determines if an item can be sent to the xPosition end of the queue.  Must be
+ * called from a critical section.
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    static BaseType_t prvQueueHasSpace( const Queue_t * pxQueue,
+                                        const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+#else
+    #define prvQueueHasSpace( pxQueue, xPosition )    ( ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) || ( ( xPosition ) == queueOVERWRITE ) ) ? pdTRUE : pdFALSE )
+#endif
+
+/*
+ * Blocks the calling task on pxEventList until pxCondition() returns pdTRUE for
+ * the queue, or the block time expires, with the same timeout handling as
+ * xQueueReceive().  The timeout state is passed in so a caller that waits more
+ * than once shares one block time between the waits.  Returns pdPASS with the
+ * critical section that the condition was last evaluated in still entered, so
+ * the caller can act on the queue before calling taskEXIT_CRITICAL().  Returns
+ * pdFAIL, outside of the critical section, on timeout.
+ */
+static BaseType_t prvQueueWaitUntil( Queue_t * const pxQueue,
+                                     BaseType_t ( * pxCondition )( const Queue_t * pxQueue ),
+                                     List_t * const pxEventList,
+                                     TimeOut_t * const pxTimeOut,
+                                     BaseType_t * const pxEntryTimeSet,
+                                     TickType_t * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Places the calling task on pxEventList, one of the two event lists of the
+ * queue.  MUST BE CALLED WITH THE SCHEDULER SUSPENDED AND THE QUEUE LOCKED.
+ */
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+    #define prvPlaceOnEventList( pxQueue, pxEventList, xTicksToWait ) \
+    vTaskPlaceOnIndexedEventList( ( pxEventList ), &( ( pxQueue )->xWaitingIndex[ ( ( pxEventList ) == &( ( pxQueue )->xTasksWaitingToSend ) ) ? 0 : 1 ] ), ( xTicksToWait ) )
+#else
+    #define prvPlaceOnEventList( pxQueue, pxEventList, xTicksToWait )    vTaskPlaceOnEventList( ( pxEventList ), ( xTicksToWait ) )
+#endif
+
+/*
+ * Conditions for prvQueueWaitUntil() that an item can be sent to the back of,
+ * or received from, the queue.
+ */
+static BaseType_t prvQueueCanSendToBack( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvQueueCanReceive( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks up to uxItemsAdded tasks waiting to receive from the queue (or
+ * notifies the queue set the queue belongs to once per item), and up to
+ * uxSlotsFreed tasks waiting to send to it, then yields once if any of them
+ * has a higher priority.  Must be called from a critical section.
+ */
+static void prvWakeQueueWaiters( Queue_t * const pxQueue,
+                                 const UBaseType_t uxItemsAdded,
+                                 const UBaseType_t uxSlotsFreed ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -210,13 +304,35 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy uxCount items to the back of, or out of the front of, a queue with at
+ * most two memcpy() calls each.  The caller must have checked there is room
+ * for, or that there are, uxCount items.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItems,
+                                 UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   int8_t * pcBuffer,
+                                   UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
  * Checks to see if a queue is a member of a queue set, and if so, notifies
  * the queue set that the queue contains data.
  */
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configUSE_QUEUE_SET_READY_LIST == 1 ) )
+
+/*
+ * Called when xQueueSelectFromSet() has taken the handle of pxMember from its
+ * set, in anticipation of the caller reading one item from the member.  Puts
+ * the handle back at the end of the set if more items remain.
+ */
+    static BaseType_t prvQueueSetMemberSelected( Queue_t * const pxMember ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -324,6 +440,12 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->ucZeroCopySlots = 0U;
+            }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -352,6 +474,12 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                 /* Ensure the event queues start in the correct state. */
                 vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
                 vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+                #if ( configUSE_EVENT_LIST_INDEX == 1 )
+                {
+                    ( void ) memset( ( void * ) pxQueue->xWaitingIndex, 0x00, sizeof( pxQueue->xWaitingIndex ) );
+                }
+                #endif
             }
         }
         taskEXIT_CRITICAL();
@@ -605,6 +733,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     #if ( configUSE_QUEUE_SETS == 1 )
     {
         pxNewQueue->pxQueueSetContainer = NULL;
+
+        #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+        {
+            pxNewQueue->uxQueueSetState = ( UBaseType_t ) 0;
+        }
+        #endif
     }
     #endif /* configUSE_QUEUE_SETS */
 
@@ -974,7 +1108,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( prvQueueHasSpace( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -1120,10 +1254,10 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvPlaceOnEventList( pxQueue, &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
                 /* Unlocking the queue means queue events can effect the
                  * event list. It is possible that interrupts occurring now
@@ -1204,7 +1338,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     /* coverity[misra_c_2012_directive_4_7_violation] */
     uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( prvQueueHasSpace( pxQueue, xCopyPosition ) != pdFALSE )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1538,7 +1672,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 
             /* Is there data in the queue now?  To be running the calling task
              * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
             {
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
@@ -1578,82 +1712,610 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                      * the block time has expired) so leave now. */
                     taskEXIT_CRITICAL();
 
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* The timeout has not expired.  If the queue is still empty place
+             * the task on the list of tasks waiting to receive from the queue. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                prvPlaceOnEventList( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  If there is no data in the queue exit, otherwise loop
+             * back and attempt to read the data. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueWaitUntil( Queue_t * const pxQueue,
+                                     BaseType_t ( * pxCondition )( const Queue_t * pxQueue ),
+                                     List_t * const pxEventList,
+                                     TimeOut_t * const pxTimeOut,
+                                     BaseType_t * const pxEntryTimeSet,
+                                     TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn = pdFAIL;
+    BaseType_t xConditionMet;
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( *pxTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+
+        if( pxCondition( pxQueue ) != pdFALSE )
+        {
+            /* Return to the caller without leaving the critical section. */
+            xReturn = pdPASS;
+            break;
+        }
+        else if( *pxTicksToWait == ( TickType_t ) 0 )
+        {
+            /* No block time is specified, or the block time has expired. */
+            taskEXIT_CRITICAL();
+            break;
+        }
+        else if( *pxEntryTimeSet == pdFALSE )
+        {
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            *pxEntryTimeSet = pdTRUE;
+        }
+        else
+        {
+            /* Entry time was already set. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can use the queue now the critical
+         * section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet.  If it has
+         * the block time is set to zero, so the next pass through the loop
+         * returns unless the condition has been met in the meantime. */
+        if( xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait ) == pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                xConditionMet = pxCondition( pxQueue );
+            }
+            taskEXIT_CRITICAL();
+
+            if( xConditionMet == pdFALSE )
+            {
+                if( pxEventList == &( pxQueue->xTasksWaitingToSend ) )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                }
+                else
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                }
+
+                prvPlaceOnEventList( pxQueue, pxEventList, *pxTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueCanSendToBack( const Queue_t * pxQueue )
+{
+    /* A reserved slot is always the one an item sent to the back of the queue
+     * would use next, so this is also the condition to reserve a slot. */
+    return prvQueueHasSpace( pxQueue, queueSEND_TO_BACK );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueCanReceive( const Queue_t * pxQueue )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+        ( queueIS_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
+    {
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeQueueWaiters( Queue_t * const pxQueue,
+                                 const UBaseType_t uxItemsAdded,
+                                 const UBaseType_t uxSlotsFreed )
+{
+    UBaseType_t uxReceiversToWake = uxItemsAdded;
+    UBaseType_t uxSendersToWake = uxSlotsFreed;
+    BaseType_t xYieldRequired = pdFALSE;
+
+    /* This function is called from a critical section.  Releasing an
+     * acquired slot adds no item, but may let in a receiver that was waiting
+     * for the release to receive the items that remain. */
+    if( ( uxReceiversToWake == ( UBaseType_t ) 0 ) &&
+        ( uxSlotsFreed > ( UBaseType_t ) 0 ) &&
+        ( prvQueueCanReceive( pxQueue ) != pdFALSE ) )
+    {
+        uxReceiversToWake = ( UBaseType_t ) 1;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        if( ( uxItemsAdded > ( UBaseType_t ) 0 ) && ( pxQueue->pxQueueSetContainer != NULL ) )
+        {
+            /* The queue set holds one handle per item in its member queues,
+             * or with configUSE_QUEUE_SET_READY_LIST one per non-empty member,
+             * in which case only the first of these notifies the set. */
+            for( uxReceiversToWake = 0; uxReceiversToWake < uxItemsAdded; uxReceiversToWake++ )
+            {
+                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            uxReceiversToWake = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_QUEUE_SETS */
+
+    while( ( uxReceiversToWake > ( UBaseType_t ) 0 ) &&
+           ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+        {
+            xYieldRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxReceiversToWake--;
+    }
+
+    /* While a slot is reserved the freed space can only be used by a task
+     * sending to the front of, or overwriting, the queue.  Which position a
+     * waiting sender uses is not known here, so wake them all and let each
+     * check again for space at its own position. */
+    if( prvQueueHasSpace( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+    else if( ( uxSendersToWake > ( UBaseType_t ) 0 ) &&
+             ( ( prvQueueHasSpace( pxQueue, queueSEND_TO_FRONT ) != pdFALSE ) ||
+               ( prvQueueHasSpace( pxQueue, queueOVERWRITE ) != pdFALSE ) ) )
+    {
+        uxSendersToWake = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToSend ) );
+    }
+    else
+    {
+        uxSendersToWake = ( UBaseType_t ) 0;
+    }
+
+    while( ( uxSendersToWake > ( UBaseType_t ) 0 ) &&
+           ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+        {
+            xYieldRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxSendersToWake--;
+    }
+
+    if( xYieldRequired != pdFALSE )
+    {
+        queueYIELD_IF_USING_PREEMPTION();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                const void * const pvItemsToQueue,
+                                UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxItemsSent = 0;
+    UBaseType_t uxItemsToCopy;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+    /* Semaphores and mutexes hold no data to send in bulk. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    while( uxItemsSent < uxItemCount )
+    {
+        if( prvQueueWaitUntil( pxQueue, prvQueueCanSendToBack, &( pxQueue->xTasksWaitingToSend ), &xTimeOut, &xEntryTimeSet, &xTicksToWait ) == pdFAIL )
+        {
+            traceQUEUE_SEND_FAILED( pxQueue );
+            break;
+        }
+
+        /* Still inside the critical section entered by prvQueueWaitUntil().
+         * Copy as many of the remaining items as there is space for. */
+        uxItemsToCopy = pxQueue->uxLength - pxQueue->uxMessagesWaiting - queueZERO_COPY_SLOTS( pxQueue );
+
+        if( uxItemsToCopy > ( uxItemCount - uxItemsSent ) )
+        {
+            uxItemsToCopy = uxItemCount - uxItemsSent;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceQUEUE_SEND( pxQueue );
+
+        /* MISRA Ref 11.5.5 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        prvCopyItemsToQueue( pxQueue, &( ( ( const int8_t * ) pvItemsToQueue )[ uxItemsSent * pxQueue->uxItemSize ] ), uxItemsToCopy );
+        prvWakeQueueWaiters( pxQueue, uxItemsToCopy, ( UBaseType_t ) 0U );
+        taskEXIT_CRITICAL();
+
+        uxItemsSent += uxItemsToCopy;
+    }
+
+    traceRETURN_xQueueSendMultiple( uxItemsSent );
+
+    return uxItemsSent;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   UBaseType_t uxMaxItems,
+                                   TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxItemsReceived = 0;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    if( uxMaxItems > ( UBaseType_t ) 0U )
+    {
+        if( prvQueueWaitUntil( pxQueue, prvQueueCanReceive, &( pxQueue->xTasksWaitingToReceive ), &xTimeOut, &xEntryTimeSet, &xTicksToWait ) != pdFAIL )
+        {
+            /* Still inside the critical section entered by prvQueueWaitUntil().
+             * Take everything that is there, up to uxMaxItems, rather than
+             * waiting for the buffer to be filled. */
+            uxItemsReceived = pxQueue->uxMessagesWaiting;
+
+            if( uxItemsReceived > uxMaxItems )
+            {
+                uxItemsReceived = uxMaxItems;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceQUEUE_RECEIVE( pxQueue );
+
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsReceived );
+            prvWakeQueueWaiters( pxQueue, ( UBaseType_t ) 0U, uxItemsReceived );
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FAILED( pxQueue );
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xQueueReceiveMultiple( uxItemsReceived );
+
+    return uxItemsReceived;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** ppvSlot,
+                              TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReserve( xQueue, ppvSlot, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+
+        /* Only queues that hold data have slots to hand out. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        if( prvQueueWaitUntil( pxQueue, prvQueueCanSendToBack, &( pxQueue->xTasksWaitingToSend ), &xTimeOut, &xEntryTimeSet, &xTicksToWait ) != pdFAIL )
+        {
+            /* Still inside the critical section entered by prvQueueWaitUntil(). */
+            pxQueue->ucZeroCopySlots |= ( uint8_t ) queueSLOT_RESERVED;
+            *ppvSlot = ( void * ) pxQueue->pcWriteTo;
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            *ppvSlot = NULL;
+            traceQUEUE_SEND_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
+
+        traceRETURN_xQueueReserve( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueCommit( QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn = pdFAIL;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueCommit( xQueue );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            /* There must be an outstanding reservation to commit. */
+            if( queueIS_SLOT_RESERVED( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                /* The item was written in place, so just publish it as
+                 * prvCopyDataToQueue() would have done. */
+                pxQueue->ucZeroCopySlots &= ( uint8_t ) ~queueSLOT_RESERVED;
+                pxQueue->pcWriteTo += pxQueue->uxItemSize;
 
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
+                if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
                 {
-                    /* The queue was empty and a block time was specified so
-                     * configure the timeout structure. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
+                    pxQueue->pcWriteTo = pxQueue->pcHead;
                 }
                 else
                 {
-                    /* Entry time was already set. */
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+
+                prvWakeQueueWaiters( pxQueue, ( UBaseType_t ) 1U, ( UBaseType_t ) 1U );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         taskEXIT_CRITICAL();
 
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now the critical section has been exited. */
+        traceRETURN_xQueueCommit( xReturn );
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+    BaseType_t xQueueAcquire( QueueHandle_t xQueue,
+                              void ** ppvItem,
+                              TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueAcquire( xQueue, ppvItem, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        if( prvQueueWaitUntil( pxQueue, prvQueueCanReceive, &( pxQueue->xTasksWaitingToReceive ), &xTimeOut, &xEntryTimeSet, &xTicksToWait ) != pdFAIL )
         {
-            /* The timeout has not expired.  If the queue is still empty place
-             * the task on the list of tasks waiting to receive from the queue. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
+            /* Still inside the critical section entered by prvQueueWaitUntil().
+             * Remove the item as prvCopyDataFromQueue() would, but leave it in
+             * place.  Its slot stays unavailable to senders until released. */
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
 
-                if( xTaskResumeAll() == pdFALSE )
-                {
-                    taskYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
             }
             else
             {
-                /* The queue contains data again.  Loop back to try and read the
-                 * data. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                mtCOVERAGE_TEST_MARKER();
             }
+
+            traceQUEUE_RECEIVE( pxQueue );
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+            pxQueue->ucZeroCopySlots |= ( uint8_t ) queueSLOT_ACQUIRED;
+            *ppvItem = ( void * ) pxQueue->u.xQueue.pcReadFrom;
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
         }
         else
         {
-            /* Timed out.  If there is no data in the queue exit, otherwise loop
-             * back and attempt to read the data. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+            *ppvItem = NULL;
+            traceQUEUE_RECEIVE_FAILED( pxQueue );
+            xReturn = errQUEUE_EMPTY;
+        }
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+        traceRETURN_xQueueAcquire( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueRelease( QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn = pdFAIL;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueRelease( xQueue );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            /* There must be an outstanding acquired item to release. */
+            if( queueIS_SLOT_ACQUIRED( pxQueue ) != pdFALSE )
             {
-                traceQUEUE_RECEIVE_FAILED( pxQueue );
-                traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+                pxQueue->ucZeroCopySlots &= ( uint8_t ) ~queueSLOT_ACQUIRED;
 
-                return errQUEUE_EMPTY;
+                prvWakeQueueWaiters( pxQueue, ( UBaseType_t ) 0U, ( UBaseType_t ) 1U );
+                xReturn = pdPASS;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xQueueRelease( xReturn );
+
+        return xReturn;
     }
-}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
@@ -1803,7 +2465,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvPlaceOnEventList( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1990,10 +2652,10 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
         {
             /* Timeout has not expired yet, check to see if there is data in the
             * queue now, and if not enter the Blocked state to wait for data. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( prvIsQueueEmptyToPeek( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvPlaceOnEventList( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -2020,7 +2682,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( prvIsQueueEmptyToPeek( pxQueue ) != pdFALSE )
             {
                 traceQUEUE_PEEK_FAILED( pxQueue );
                 traceRETURN_xQueuePeek( errQUEUE_EMPTY );
@@ -2073,7 +2735,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
         /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueIS_SLOT_ACQUIRED( pxQueue ) == pdFALSE ) )
         {
             const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -2228,7 +2890,7 @@ UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
 
     portBASE_TYPE_ENTER_CRITICAL();
     {
-        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting - queueZERO_COPY_SLOTS( pxQueue ) );
     }
     portBASE_TYPE_EXIT_CRITICAL();
 
@@ -2343,6 +3005,44 @@ void vQueueDelete( QueueHandle_t xQueue )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+
+    BaseType_t xQueueGetHighestReceiverPriority( QueueHandle_t xQueue,
+                                                 UBaseType_t * const puxPriority )
+    {
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xQueueGetHighestReceiverPriority( xQueue, puxPriority );
+
+        configASSERT( pxQueue );
+        configASSERT( puxPriority );
+
+        /* The list is in priority order and each item value holds
+         * configMAX_PRIORITIES minus the priority of its task, so the head
+         * is normally the highest priority waiter.  The list is not re-sorted
+         * when priority inheritance or vTaskPrioritySet() rewrites the value
+         * of a waiting task in place, so after that the head can be a waiter
+         * of lower priority than another further down the list, and the
+         * result is only a hint. */
+        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+        {
+            *puxPriority = ( UBaseType_t ) ( ( TickType_t ) configMAX_PRIORITIES - listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueGetHighestReceiverPriority( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_LIGHTWEIGHT_SYNC */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
 {
     traceENTER_uxQueueGetQueueItemSize( xQueue );
@@ -2494,6 +3194,69 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItems,
+                                 UBaseType_t uxCount )
+{
+    size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+    size_t xBytesToEnd = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+    /* The storage area is a whole number of items long, so a wrap never
+     * splits an item.  Copy up to the end of the storage area, then the rest
+     * from its start. */
+    if( xBytes >= xBytesToEnd )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytesToEnd );
+        ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pcItems[ xBytesToEnd ] ), xBytes - xBytesToEnd );
+        pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xBytesToEnd );
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytes );
+        pxQueue->pcWriteTo += xBytes;
+    }
+
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxCount );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   int8_t * pcBuffer,
+                                   UBaseType_t uxCount )
+{
+    size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+    int8_t * pcFirst = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+    size_t xBytesToEnd;
+
+    /* pcReadFrom points to the last item read, so the first item to copy is
+     * the one after it. */
+    if( pcFirst >= pxQueue->u.xQueue.pcTail )
+    {
+        pcFirst = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xBytesToEnd = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcFirst );
+
+    if( xBytes > xBytesToEnd )
+    {
+        ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcFirst, xBytesToEnd );
+        ( void ) memcpy( ( void * ) &( pcBuffer[ xBytesToEnd ] ), ( const void * ) pxQueue->pcHead, xBytes - xBytesToEnd );
+        pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( xBytes - xBytesToEnd ) - pxQueue->uxItemSize;
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcFirst, xBytes );
+        pxQueue->u.xQueue.pcReadFrom = pcFirst + xBytes - pxQueue->uxItemSize;
+    }
+
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxCount );
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2618,6 +3381,29 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
 {
     BaseType_t xReturn;
 
+    taskENTER_CRITICAL();
+    {
+        /* Nothing can be received while an acquired item is outstanding. */
+        if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) ||
+            ( queueIS_SLOT_ACQUIRED( pxQueue ) != pdFALSE ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsQueueEmptyToPeek( const Queue_t * pxQueue )
+{
+    BaseType_t xReturn;
+
     taskENTER_CRITICAL();
     {
         if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
@@ -2659,13 +3445,14 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 }
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xPosition )
 {
     BaseType_t xReturn;
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( prvQueueHasSpace( pxQueue, xPosition ) == pdFALSE )
         {
             xReturn = pdTRUE;
         }
@@ -2680,6 +3467,43 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static BaseType_t prvQueueHasSpace( const Queue_t * pxQueue,
+                                        const BaseType_t xPosition )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( xPosition == queueOVERWRITE )
+        {
+            /* The only item of the queue is written in place. */
+            if( queueZERO_COPY_SLOTS( pxQueue ) == ( UBaseType_t ) 0U )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        else if( ( pxQueue->uxMessagesWaiting + queueZERO_COPY_SLOTS( pxQueue ) ) < pxQueue->uxLength )
+        {
+            if( xPosition == queueSEND_TO_BACK )
+            {
+                xReturn = ( queueIS_SLOT_RESERVED( pxQueue ) != pdFALSE ) ? pdFALSE : pdTRUE;
+            }
+            else
+            {
+                xReturn = ( queueIS_SLOT_ACQUIRED( pxQueue ) != pdFALSE ) ? pdFALSE : pdTRUE;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 {
     BaseType_t xReturn;
@@ -2720,7 +3544,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * between the check to see if the queue is full and blocking on the queue. */
         portDISABLE_INTERRUPTS();
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
             {
                 /* The queue is full - do we want to block or just leave without
                  * posting? */
@@ -3234,9 +4058,26 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                  * items in the queue/semaphore. */
                 xReturn = pdFAIL;
             }
+
+            #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+                else if( ( ( Queue_t * ) xQueueSet )->uxQueueSetState >= ( ( Queue_t * ) xQueueSet )->uxLength )
+                {
+                    /* The set holds the handle of each member at most once, so
+                     * its length limits the number of members. */
+                    xReturn = pdFAIL;
+                }
+            #endif /* configUSE_QUEUE_SET_READY_LIST */
             else
             {
                 ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+
+                #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+                {
+                    ( ( Queue_t * ) xQueueOrSemaphore )->uxQueueSetState = ( UBaseType_t ) pdFALSE;
+                    ( ( Queue_t * ) xQueueSet )->uxQueueSetState++;
+                }
+                #endif
+
                 xReturn = pdPASS;
             }
         }
@@ -3278,6 +4119,12 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             {
                 /* The queue is no longer contained in the set. */
                 pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+
+                #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+                {
+                    ( ( Queue_t * ) xQueueSet )->uxQueueSetState--;
+                }
+                #endif
             }
             taskEXIT_CRITICAL();
             xReturn = pdPASS;
@@ -3302,6 +4149,32 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait );
 
+        #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+        {
+            if( xReturn != NULL )
+            {
+                taskENTER_CRITICAL();
+                {
+                    if( prvQueueSetMemberSelected( ( Queue_t * ) xReturn ) != pdFALSE )
+                    {
+                        /* Putting the handle back unblocked a higher priority
+                         * task that was also waiting on the set. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_QUEUE_SET_READY_LIST */
+
         traceRETURN_xQueueSelectFromSet( xReturn );
 
         return xReturn;
@@ -3320,6 +4193,27 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
 
+        #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+        {
+            if( xReturn != NULL )
+            {
+                UBaseType_t uxSavedInterruptStatus;
+
+                /* As with xQueueReceiveFromISR() above, a task unblocked by
+                 * the handle being put back does not request a switch. */
+                uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                {
+                    ( void ) prvQueueSetMemberSelected( ( Queue_t * ) xReturn );
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_QUEUE_SET_READY_LIST */
+
         traceRETURN_xQueueSelectFromSetFromISR( xReturn );
 
         return xReturn;
@@ -3330,7 +4224,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
 #if ( configUSE_QUEUE_SETS == 1 )
 
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue )
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue )
     {
         Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
         BaseType_t xReturn = pdFALSE;
@@ -3341,9 +4235,29 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+        {
+            /* The set holds the handle of a non-empty member once, however
+             * many items the member holds.  If the handle is already there
+             * the set will return the member again, so nothing is sent. */
+            if( pxQueue->uxQueueSetState != ( UBaseType_t ) pdFALSE )
+            {
+                pxQueueSetContainer = NULL;
+            }
+            else
+            {
+                configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+                pxQueue->uxQueueSetState = ( UBaseType_t ) pdTRUE;
+            }
+        }
+        #else
+        {
+            configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+        }
+        #endif /* configUSE_QUEUE_SET_READY_LIST */
+
+        if( ( pxQueueSetContainer != NULL ) && ( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength ) )
         {
             const int8_t cTxLock = pxQueueSetContainer->cTxLock;
 
@@ -3385,3 +4299,31 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configUSE_QUEUE_SET_READY_LIST == 1 ) )
+
+    static BaseType_t prvQueueSetMemberSelected( Queue_t * const pxMember )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* This function must be called from a critical section. */
+
+        pxMember->uxQueueSetState = ( UBaseType_t ) pdFALSE;
+
+        /* The caller reads one item, so the handle goes back at the end of the
+         * set if there is more than one.  Items sent after this point notify
+         * the set themselves. */
+        if( ( pxMember->uxMessagesWaiting > ( UBaseType_t ) 1 ) && ( pxMember->pxQueueSetContainer != NULL ) )
+        {
+            xReturn = prvNotifyQueueSetContainer( pxMember );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ( configUSE_QUEUE_SETS == 1 ) && ( configUSE_QUEUE_SET_READY_LIST == 1 ) ) */
@@ -0,0 +1,765 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_queue.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include SPSC queue functionality. This #if is closed at the very bottom of
+ * this file. If you want to include SPSC queues then ensure
+ * configUSE_SPSC_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_queue.c
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build spsc_queue.c
+    #endif
+
+/* portMEMORY_BARRIER() is only relied on to order accesses on one core, see
+ * the note in spsc_queue.h. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error spsc_queue.c only supports configNUMBER_OF_CORES set to 1
+    #endif
+
+/* Bits stored in the ucFlags field of the queue. */
+    #define spscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the queue was created using statically allocated memory. */
+
+/*lint -save -e9058 Same struct definition across two files is not a MISRA violation. */
+
+/* Structure that holds state information on the queue.  The head and tail
+ * indexes run from 0 to ( 2 * uxLength ) - 1, so a full queue (the indexes are
+ * uxLength apart) can be told apart from an empty one (the indexes are equal)
+ * without giving up a slot. */
+typedef struct SpscQueueDef_t
+{
+    volatile UBaseType_t uxHead;                  /* Index of the next slot to write.  Only written by the producer. */
+    volatile UBaseType_t uxTail;                  /* Index of the next slot to read.  Only written by the consumer. */
+    UBaseType_t uxLength;                         /* The number of items the queue can hold. */
+    UBaseType_t uxItemSize;                       /* The size of each item. */
+    uint8_t * pucStorage;                         /* Points to the start of the storage area. */
+    TaskHandle_t volatile xTaskWaitingToReceive;  /* Holds the handle of a consumer task waiting for an item, or NULL. */
+    TaskHandle_t volatile xTaskWaitingToSend;     /* Holds the handle of a producer task waiting for space, or NULL. */
+    UBaseType_t uxNotificationIndex;              /* The index the waiting tasks are notified on, by default tskDEFAULT_INDEX_TO_NOTIFY. */
+    uint8_t ucFlags;
+} SpscQueue_t;
+
+/*
+ * The number of items between uxTail and uxHead.
+ */
+static UBaseType_t prvItemsInQueue( const SpscQueue_t * const pxQueue,
+                                    UBaseType_t uxHead,
+                                    UBaseType_t uxTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * The address of the slot an index refers to, and the index after it.
+ */
+static uint8_t * prvSlotAddress( const SpscQueue_t * const pxQueue,
+                                 UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvNextIndex( const SpscQueue_t * const pxQueue,
+                                 UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the producer to try to copy an item into the queue, or by the
+ * consumer to try to copy one out.  Neither enters a critical section unless
+ * the other side is blocked and has to be notified.
+ */
+static BaseType_t prvTrySend( SpscQueue_t * const pxQueue,
+                              const void * pvItemToQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+static BaseType_t prvTryReceive( SpscQueue_t * const pxQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the task, if any, recorded in *pxWaitingTask.  From an interrupt
+ * pxHigherPriorityTaskWoken is updated, from a task it is NULL.
+ */
+static void prvNotifyWaitingTask( const SpscQueue_t * const pxQueue,
+                                  TaskHandle_t volatile * const pxWaitingTask,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task until the other side moves *puxOtherIndex away from
+ * uxIndexSeen, or xTicksToWait expires.
+ */
+static void prvWaitForOtherSide( const SpscQueue_t * const pxQueue,
+                                 TaskHandle_t volatile * const pxWaitingTask,
+                                 const volatile UBaseType_t * const puxOtherIndex,
+                                 UBaseType_t uxIndexSeen,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both create functions to initialise the queue structure.
+ */
+static void prvInitialiseNewSpscQueue( SpscQueue_t * const pxQueue,
+                                       UBaseType_t uxQueueLength,
+                                       UBaseType_t uxItemSize,
+                                       uint8_t * const pucQueueStorage,
+                                       uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscQueueHandle_t xSpscQueueCreate( UBaseType_t uxQueueLength,
+                                        UBaseType_t uxItemSize )
+    {
+        SpscQueue_t * pxNewQueue = NULL;
+        size_t xQueueSizeInBytes;
+
+        traceENTER_xSpscQueueCreate( uxQueueLength, uxItemSize );
+
+        configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* Check the index range and the storage size cannot overflow. */
+        if( ( uxQueueLength <= ( ( ( UBaseType_t ) ~( ( UBaseType_t ) 0 ) ) / ( UBaseType_t ) 2 ) ) &&
+            ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
+            ( ( SIZE_MAX - sizeof( SpscQueue_t ) ) >= ( ( size_t ) uxQueueLength * ( size_t ) uxItemSize ) ) )
+        {
+            xQueueSizeInBytes = ( size_t ) uxQueueLength * ( size_t ) uxItemSize;
+
+            /* The structure and storage area are allocated in one call, with
+             * the storage area following the structure. */
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNewQueue = ( SpscQueue_t * ) pvPortMalloc( sizeof( SpscQueue_t ) + xQueueSizeInBytes );
+
+            if( pxNewQueue != NULL )
+            {
+                prvInitialiseNewSpscQueue( pxNewQueue,
+                                           uxQueueLength,
+                                           uxItemSize,
+                                           ( ( uint8_t * ) pxNewQueue ) + sizeof( SpscQueue_t ),
+                                           ( uint8_t ) 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xSpscQueueCreate( pxNewQueue );
+
+        return pxNewQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SpscQueueHandle_t xSpscQueueCreateStatic( UBaseType_t uxQueueLength,
+                                              UBaseType_t uxItemSize,
+                                              uint8_t * const pucQueueStorage,
+                                              StaticSpscQueue_t * const pxStaticQueue )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        SpscQueue_t * const pxQueue = ( SpscQueue_t * ) pxStaticQueue;
+        SpscQueueHandle_t xReturn = NULL;
+
+        traceENTER_xSpscQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue );
+
+        configASSERT( pucQueueStorage );
+        configASSERT( pxStaticQueue );
+        configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+        configASSERT( uxQueueLength <= ( ( ( UBaseType_t ) ~( ( UBaseType_t ) 0 ) ) / ( UBaseType_t ) 2 ) );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticSpscQueue_t equals the size of the real
+             * queue structure. */
+            volatile size_t xSize = sizeof( StaticSpscQueue_t );
+            configASSERT( xSize == sizeof( SpscQueue_t ) );
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucQueueStorage != NULL ) && ( pxStaticQueue != NULL ) )
+        {
+            prvInitialiseNewSpscQueue( pxQueue,
+                                       uxQueueLength,
+                                       uxItemSize,
+                                       pucQueueStorage,
+                                       spscFLAGS_IS_STATICALLY_ALLOCATED );
+            xReturn = pxQueue;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xSpscQueueCreateStatic( xReturn );
+
+        return xReturn;
+    }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vSpscQueueDelete( SpscQueueHandle_t xQueue )
+{
+    SpscQueue_t * pxQueue = xQueue;
+
+    traceENTER_vSpscQueueDelete( xQueue );
+
+    configASSERT( pxQueue );
+    configASSERT( pxQueue->xTaskWaitingToReceive == NULL );
+    configASSERT( pxQueue->xTaskWaitingToSend == NULL );
+
+    if( ( pxQueue->ucFlags & spscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the storage area were allocated using a
+             * single call to pvPortMalloc(), hence only one call to
+             * vPortFree() is required. */
+            vPortFree( ( void * ) pxQueue );
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xQueue == ( SpscQueueHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure and storage area were statically allocated, so there
+         * is nothing to free.  Clear the structure so it is obviously stale. */
+        ( void ) memset( pxQueue, 0x00, sizeof( SpscQueue_t ) );
+    }
+
+    traceRETURN_vSpscQueueDelete();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueSend( SpscQueueHandle_t xQueue,
+                           const void * pvItemToQueue,
+                           TickType_t xTicksToWait )
+{
+    SpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    BaseType_t xTimedOut;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxTailSeen;
+
+    traceENTER_xSpscQueueSend( xQueue, pvItemToQueue, xTicksToWait );
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        /* Remember where the consumer was before trying, so the wait below
+         * returns as soon as it has made any space. */
+        uxTailSeen = pxQueue->uxTail;
+
+        xReturn = prvTrySend( pxQueue, pvItemToQueue, NULL );
+
+        if( ( xReturn != pdFAIL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+        {
+            break;
+        }
+
+        if( xEntryTimeSet == pdFALSE )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+            xEntryTimeSet = pdTRUE;
+            xTimedOut = pdFALSE;
+        }
+        else
+        {
+            /* Sets xTicksToWait to 0 if the block time has expired, so the
+             * next pass makes one last attempt. */
+            xTimedOut = xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+        }
+
+        if( xTimedOut == pdFALSE )
+        {
+            traceBLOCKING_ON_SPSC_QUEUE_SEND( xQueue );
+            prvWaitForOtherSide( pxQueue, &( pxQueue->xTaskWaitingToSend ), &( pxQueue->uxTail ), uxTailSeen, xTicksToWait );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( xReturn == pdFAIL )
+    {
+        xReturn = errQUEUE_FULL;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xSpscQueueSend( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueSendFromISR( SpscQueueHandle_t xQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    traceENTER_xSpscQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    /* A local is passed in so prvTrySend() can tell it is called from an
+     * interrupt even when pxHigherPriorityTaskWoken is NULL. */
+    xReturn = prvTrySend( pxQueue, pvItemToQueue, &xHigherPriorityTaskWoken );
+
+    if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn == pdFAIL )
+    {
+        xReturn = errQUEUE_FULL;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xSpscQueueSendFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueReceive( SpscQueueHandle_t xQueue,
+                              void * const pvBuffer,
+                              TickType_t xTicksToWait )
+{
+    SpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    BaseType_t xTimedOut;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxHeadSeen;
+
+    traceENTER_xSpscQueueReceive( xQueue, pvBuffer, xTicksToWait );
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        uxHeadSeen = pxQueue->uxHead;
+
+        xReturn = prvTryReceive( pxQueue, pvBuffer, NULL );
+
+        if( ( xReturn != pdFAIL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+        {
+            break;
+        }
+
+        if( xEntryTimeSet == pdFALSE )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+            xEntryTimeSet = pdTRUE;
+            xTimedOut = pdFALSE;
+        }
+        else
+        {
+            xTimedOut = xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+        }
+
+        if( xTimedOut == pdFALSE )
+        {
+            traceBLOCKING_ON_SPSC_QUEUE_RECEIVE( xQueue );
+            prvWaitForOtherSide( pxQueue, &( pxQueue->xTaskWaitingToReceive ), &( pxQueue->uxHead ), uxHeadSeen, xTicksToWait );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( xReturn == pdFAIL )
+    {
+        xReturn = errQUEUE_EMPTY;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xSpscQueueReceive( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueReceiveFromISR( SpscQueueHandle_t xQueue,
+                                     void * const pvBuffer,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    traceENTER_xSpscQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+
+    xReturn = prvTryReceive( pxQueue, pvBuffer, &xHigherPriorityTaskWoken );
+
+    if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn == pdFAIL )
+    {
+        xReturn = errQUEUE_EMPTY;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xSpscQueueReceiveFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSpscQueueMessagesWaiting( SpscQueueHandle_t xQueue )
+{
+    const SpscQueue_t * const pxQueue = xQueue;
+    UBaseType_t uxReturn;
+
+    traceENTER_uxSpscQueueMessagesWaiting( xQueue );
+
+    configASSERT( pxQueue );
+
+    uxReturn = prvItemsInQueue( pxQueue, pxQueue->uxHead, pxQueue->uxTail );
+
+    traceRETURN_uxSpscQueueMessagesWaiting( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSpscQueueSpacesAvailable( SpscQueueHandle_t xQueue )
+{
+    const SpscQueue_t * const pxQueue = xQueue;
+    UBaseType_t uxReturn;
+
+    traceENTER_uxSpscQueueSpacesAvailable( xQueue );
+
+    configASSERT( pxQueue );
+
+    uxReturn = pxQueue->uxLength - prvItemsInQueue( pxQueue, pxQueue->uxHead, pxQueue->uxTail );
+
+    traceRETURN_uxSpscQueueSpacesAvailable( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vSpscQueueSetNotificationIndex( SpscQueueHandle_t xQueue,
+                                     UBaseType_t uxNotificationIndex )
+{
+    SpscQueue_t * const pxQueue = xQueue;
+
+    traceENTER_vSpscQueueSetNotificationIndex( xQueue, uxNotificationIndex );
+
+    configASSERT( pxQueue );
+
+    /* There should be no task waiting otherwise we'd never resume them. */
+    configASSERT( pxQueue->xTaskWaitingToReceive == NULL );
+    configASSERT( pxQueue->xTaskWaitingToSend == NULL );
+
+    /* Check that the task notification index is valid. */
+    configASSERT( uxNotificationIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+    pxQueue->uxNotificationIndex = uxNotificationIndex;
+
+    traceRETURN_vSpscQueueSetNotificationIndex();
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvItemsInQueue( const SpscQueue_t * const pxQueue,
+                                    UBaseType_t uxHead,
+                                    UBaseType_t uxTail )
+{
+    UBaseType_t uxCount;
+
+    if( uxHead >= uxTail )
+    {
+        uxCount = uxHead - uxTail;
+    }
+    else
+    {
+        uxCount = ( uxHead + ( pxQueue->uxLength * ( UBaseType_t ) 2 ) ) - uxTail;
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t * prvSlotAddress( const SpscQueue_t * const pxQueue,
+                                 UBaseType_t uxIndex )
+{
+    if( uxIndex >= pxQueue->uxLength )
+    {
+        uxIndex -= pxQueue->uxLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return &( pxQueue->pucStorage[ uxIndex * pxQueue->uxItemSize ] );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvNextIndex( const SpscQueue_t * const pxQueue,
+                                 UBaseType_t uxIndex )
+{
+    uxIndex++;
+
+    if( uxIndex == ( pxQueue->uxLength * ( UBaseType_t ) 2 ) )
+    {
+        uxIndex = ( UBaseType_t ) 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxIndex;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTrySend( SpscQueue_t * const pxQueue,
+                              const void * pvItemToQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn = pdFAIL;
+    const UBaseType_t uxHead = pxQueue->uxHead;
+    const UBaseType_t uxTail = pxQueue->uxTail;
+
+    /* The consumer must have finished reading a slot before it is reused, so
+     * read its index before writing any data. */
+    portMEMORY_BARRIER();
+
+    if( prvItemsInQueue( pxQueue, uxHead, uxTail ) < pxQueue->uxLength )
+    {
+        ( void ) memcpy( ( void * ) prvSlotAddress( pxQueue, uxHead ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+
+        /* Publish the item only once its data is in place. */
+        portMEMORY_BARRIER();
+        pxQueue->uxHead = prvNextIndex( pxQueue, uxHead );
+
+        /* The new head must be visible before checking for a waiting
+         * consumer, as the consumer records itself before checking the head
+         * one last time.  One of the two always sees the other. */
+        portMEMORY_BARRIER();
+        prvNotifyWaitingTask( pxQueue, &( pxQueue->xTaskWaitingToReceive ), pxHigherPriorityTaskWoken );
+
+        traceSPSC_QUEUE_SEND( pxQueue );
+        xReturn = pdPASS;
+    }
+    else
+    {
+        traceSPSC_QUEUE_SEND_FAILED( pxQueue );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTryReceive( SpscQueue_t * const pxQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn = pdFAIL;
+    const UBaseType_t uxTail = pxQueue->uxTail;
+    const UBaseType_t uxHead = pxQueue->uxHead;
+
+    /* Do not read the data before the head that says it is there. */
+    portMEMORY_BARRIER();
+
+    if( uxHead != uxTail )
+    {
+        ( void ) memcpy( pvBuffer, ( const void * ) prvSlotAddress( pxQueue, uxTail ), ( size_t ) pxQueue->uxItemSize );
+
+        /* Free the slot only once the data has been copied out of it. */
+        portMEMORY_BARRIER();
+        pxQueue->uxTail = prvNextIndex( pxQueue, uxTail );
+
+        portMEMORY_BARRIER();
+        prvNotifyWaitingTask( pxQueue, &( pxQueue->xTaskWaitingToSend ), pxHigherPriorityTaskWoken );
+
+        traceSPSC_QUEUE_RECEIVE( pxQueue );
+        xReturn = pdPASS;
+    }
+    else
+    {
+        traceSPSC_QUEUE_RECEIVE_FAILED( pxQueue );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTask( const SpscQueue_t * const pxQueue,
+                                  TaskHandle_t volatile * const pxWaitingTask,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    const TaskHandle_t xWaitingTask = *pxWaitingTask;
+
+    /* This is the only place the other side's task is touched, and the only
+     * path from the fast path into the kernel. */
+    if( xWaitingTask != NULL )
+    {
+        /* Clear the record so later items do not notify again.  If the task
+         * has already recorded itself again for a later wait, it cleared its
+         * notification state first, so the notification below still
+         * unblocks it. */
+        *pxWaitingTask = NULL;
+
+        if( pxHigherPriorityTaskWoken == NULL )
+        {
+            ( void ) xTaskNotifyIndexed( xWaitingTask, pxQueue->uxNotificationIndex, ( uint32_t ) 0, eNoAction );
+        }
+        else
+        {
+            ( void ) xTaskNotifyIndexedFromISR( xWaitingTask, pxQueue->uxNotificationIndex, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForOtherSide( const SpscQueue_t * const pxQueue,
+                                 TaskHandle_t volatile * const pxWaitingTask,
+                                 const volatile UBaseType_t * const puxOtherIndex,
+                                 UBaseType_t uxIndexSeen,
+                                 TickType_t xTicksToWait )
+{
+    /* Drop any notification left from an earlier wait before recording this
+     * task, then check the other side has still not moved.  If it moves after
+     * the check it sees the record and notifies this task. */
+    ( void ) xTaskNotifyStateClearIndexed( NULL, pxQueue->uxNotificationIndex );
+    *pxWaitingTask = xTaskGetCurrentTaskHandle();
+    portMEMORY_BARRIER();
+
+    if( *puxOtherIndex == uxIndexSeen )
+    {
+        ( void ) xTaskNotifyWaitIndexed( pxQueue->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    *pxWaitingTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSpscQueue( SpscQueue_t * const pxQueue,
+                                       UBaseType_t uxQueueLength,
+                                       UBaseType_t uxItemSize,
+                                       uint8_t * const pucQueueStorage,
+                                       uint8_t ucFlags )
+{
+    ( void ) memset( ( void * ) pxQueue, 0x00, sizeof( SpscQueue_t ) );
+    pxQueue->uxLength = uxQueueLength;
+    pxQueue->uxItemSize = uxItemSize;
+    pxQueue->pucStorage = pucQueueStorage;
+    pxQueue->uxNotificationIndex = tskDEFAULT_INDEX_TO_NOTIFY;
+    pxQueue->ucFlags = ucFlags;
+}
+
+/* This entire source file will be skipped if the application is not configured
+ * to include SPSC queue functionality. This #if is closed at the very bottom of
+ * this file. If you want to include SPSC queues then ensure
+ * configUSE_SPSC_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_SPSC_QUEUES == 1 */
@@ -297,6 +297,47 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                        size_t xSpace,
                                        size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
 
+/*
+ * Gather version of prvWriteMessageToBuffer().  Writes the uxFragmentCount
+ * regions described by pxFragments, xDataLengthBytes bytes in total, as one
+ * message (message buffer) or as many bytes as fit (stream buffer).  xHead is
+ * only updated once all the fragments have been written.
+ */
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         const StreamBufferVector_t * pxFragments,
+                                         UBaseType_t uxFragmentCount,
+                                         size_t xDataLengthBytes,
+                                         size_t xSpace,
+                                         size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task, for at most xTicksToWait ticks, until at least
+ * xRequiredSpace bytes are free in the buffer.  Returns the free space last
+ * observed.
+ */
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task, for at most xTicksToWait ticks, until more than
+ * xBytesToStoreMessageLength bytes are in the buffer.  Returns the number of
+ * bytes in the buffer.
+ */
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Describes the xCount bytes of the buffer's data storage area that start at
+ * xIndex as at most two contiguous spans, the second being used only if the
+ * region wraps past the end of the storage area.
+ */
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                         size_t xIndex,
+                         size_t xCount,
+                         StreamBufferVector_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
 /*
  * Copies xCount bytes from the pxStreamBuffer's data storage area to pucData.
  * This function does not update the buffer's xTail pointer, so multiple reads
@@ -811,9 +852,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xSpace = 0;
+    size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
-    TimeOut_t xTimeOut;
     size_t xMaxReportedSpace = 0;
 
     traceENTER_xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
@@ -864,6 +904,99 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         }
     }
 
+    xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+    }
+
+    traceRETURN_xStreamBufferSend( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
+                                 const void * pvTxData,
+                                 size_t xDataLengthBytes,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xSpace;
+    size_t xRequiredSpace = xDataLengthBytes;
+
+    traceENTER_xStreamBufferSendFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken );
+
+    configASSERT( pvTxData );
+    configASSERT( pxStreamBuffer );
+
+    /* This send function is used to write to both message buffers and stream
+     * buffers.  If this is a message buffer then the space needed must be
+     * increased by the amount of bytes needed to store the length of the
+     * message. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+    traceRETURN_xStreamBufferSendFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait )
+{
+    size_t xSpace = 0;
+    TimeOut_t xTimeOut;
+
     if( xTicksToWait != ( TickType_t ) 0 )
     {
         vTaskSetTimeOutState( &xTimeOut );
@@ -893,7 +1026,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
             }
             taskEXIT_CRITICAL();
 
-            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
             ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToSend = NULL;
         } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
@@ -912,7 +1045,81 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFragments( StreamBufferHandle_t xStreamBuffer,
+                                   const StreamBufferVector_t * pxFragments,
+                                   UBaseType_t uxFragmentCount,
+                                   TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xSpace, xRequiredSpace;
+    size_t xDataLengthBytes = 0;
+    size_t xMaxReportedSpace;
+    UBaseType_t ux;
+
+    traceENTER_xStreamBufferSendFragments( xStreamBuffer, pxFragments, uxFragmentCount, xTicksToWait );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxFragments != NULL ) || ( uxFragmentCount == ( UBaseType_t ) 0 ) );
+
+    for( ux = 0; ux < uxFragmentCount; ux++ )
+    {
+        configASSERT( ( pxFragments[ ux ].pvData != NULL ) || ( pxFragments[ ux ].xLength == ( size_t ) 0 ) );
+        xDataLengthBytes += pxFragments[ ux ].xLength;
+
+        /* Overflow? */
+        configASSERT( xDataLengthBytes >= pxFragments[ ux ].xLength );
+    }
+
+    xRequiredSpace = xDataLengthBytes;
+    xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+
+    /* Size the write exactly as xStreamBufferSend() would for a single buffer
+     * of xDataLengthBytes bytes. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+        /* Overflow? */
+        configASSERT( xRequiredSpace > xDataLengthBytes );
+
+        if( xRequiredSpace > xMaxReportedSpace )
+        {
+            /* The message would not fit even if the entire buffer was empty,
+             * so don't wait for space. */
+            xTicksToWait = ( TickType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        if( xRequiredSpace > xMaxReportedSpace )
+        {
+            xRequiredSpace = xMaxReportedSpace;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+        xReturn = prvWriteFragmentsToBuffer( pxStreamBuffer, pxFragments, uxFragmentCount, xDataLengthBytes, xSpace, xRequiredSpace );
+    }
+    else
+    {
+        /* Nothing to send - an empty message is not written to a message
+         * buffer by xStreamBufferSend() either. */
+        xReturn = 0;
+    }
 
     if( xReturn > ( size_t ) 0 )
     {
@@ -934,66 +1141,75 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
     }
 
-    traceRETURN_xStreamBufferSend( xReturn );
+    traceRETURN_xStreamBufferSendFragments( xReturn );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
-                                 const void * pvTxData,
-                                 size_t xDataLengthBytes,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         const StreamBufferVector_t * pxFragments,
+                                         UBaseType_t uxFragmentCount,
+                                         size_t xDataLengthBytes,
+                                         size_t xSpace,
+                                         size_t xRequiredSpace )
 {
-    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xSpace;
-    size_t xRequiredSpace = xDataLengthBytes;
-
-    traceENTER_xStreamBufferSendFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken );
-
-    configASSERT( pvTxData );
-    configASSERT( pxStreamBuffer );
+    size_t xNextHead = pxStreamBuffer->xHead;
+    size_t xRemaining, xCount;
+    configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+    UBaseType_t ux;
 
-    /* This send function is used to write to both message buffers and stream
-     * buffers.  If this is a message buffer then the space needed must be
-     * increased by the amount of bytes needed to store the length of the
-     * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+        configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+        if( xSpace >= xRequiredSpace )
+        {
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+        }
+        else
+        {
+            /* Not enough space, so do not write data to the buffer. */
+            xDataLengthBytes = 0;
+        }
     }
     else
     {
-        mtCOVERAGE_TEST_MARKER();
+        xDataLengthBytes = configMIN( xDataLengthBytes, xSpace );
     }
 
-    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+    xRemaining = xDataLengthBytes;
 
-    if( xReturn > ( size_t ) 0 )
+    for( ux = 0; ( ux < uxFragmentCount ) && ( xRemaining != ( size_t ) 0 ); ux++ )
     {
-        /* Was a task waiting for the data? */
-        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        xCount = configMIN( pxFragments[ ux ].xLength, xRemaining );
+
+        if( xCount != ( size_t ) 0 )
         {
-            /* MISRA Ref 4.7.1 [Return value shall be checked] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-            /* coverity[misra_c_2012_directive_4_7_violation] */
-            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxFragments[ ux ].pvData, xCount, xNextHead );
+            xRemaining -= xCount;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
+
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        /* Publish the whole write at once. */
+        pxStreamBuffer->xHead = xNextHead;
+    }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
-    traceRETURN_xStreamBufferSendFromISR( xReturn );
-
-    return xReturn;
+    return xDataLengthBytes;
 }
 /*-----------------------------------------------------------*/
 
@@ -1083,6 +1299,46 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesToStoreMessageLength = 0;
     }
 
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+
+    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
+     * holds the number of bytes used to store the message length) or a stream of
+     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+     * available must be greater than xBytesToStoreMessageLength to be able to
+     * read bytes from the buffer. */
+    if( xBytesAvailable > xBytesToStoreMessageLength )
+    {
+        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xReceivedLength != ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xStreamBufferReceive( xReceivedLength );
+
+    return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait )
+{
+    size_t xBytesAvailable;
+
     if( xTicksToWait != ( TickType_t ) 0 )
     {
         /* Checking if there is data and clearing the notification state must be
@@ -1117,7 +1373,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         if( xBytesAvailable <= xBytesToStoreMessageLength )
         {
             /* Wait for data to be available. */
-            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
             ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToReceive = NULL;
 
@@ -1134,35 +1390,252 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
     }
 
-    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
-     * holds the number of bytes used to store the message length) or a stream of
-     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-     * available must be greater than xBytesToStoreMessageLength to be able to
-     * read bytes from the buffer. */
-    if( xBytesAvailable > xBytesToStoreMessageLength )
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxStreamBufferReceiveMessages( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferVector_t * pxMessages,
+                                           UBaseType_t uxMaxMessages,
+                                           TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    UBaseType_t uxReceived = 0;
+    size_t xBytesAvailable, xMessageLength, xNextTail, xDataTail;
+    size_t xReceivedLength = 0;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+
+    traceENTER_uxStreamBufferReceiveMessages( xStreamBuffer, pxMessages, uxMaxMessages, xTicksToWait );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxMessages );
+
+    /* Only message buffers hold discrete messages. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTicksToWait );
+    xNextTail = pxStreamBuffer->xTail;
+
+    /* Copy out every message that was complete when the buffer was sampled.
+     * The tail is only moved once, after the loop, so the writer sees all the
+     * freed space at the same time. */
+    while( ( uxReceived < uxMaxMessages ) && ( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
     {
-        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+        xDataTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+        xMessageLength = ( size_t ) xTempMessageLength;
 
-        /* Was a task waiting for space in the buffer? */
-        if( xReceivedLength != ( size_t ) 0 )
+        if( xMessageLength > pxMessages[ uxReceived ].xLength )
         {
-            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
-            prvRECEIVE_COMPLETED( xStreamBuffer );
+            /* Leave this message, and those after it, in the buffer. */
+            break;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        configASSERT( pxMessages[ uxReceived ].pvData );
+
+        /* MISRA Ref 11.5.5 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pxMessages[ uxReceived ].pvData, xMessageLength, xDataTail );
+        pxMessages[ uxReceived ].xLength = xMessageLength;
+
+        xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH + xMessageLength;
+        xReceivedLength += xMessageLength;
+        uxReceived++;
+    }
+
+    if( uxReceived != ( UBaseType_t ) 0 )
+    {
+        pxStreamBuffer->xTail = xNextTail;
+
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+        prvRECEIVE_COMPLETED( xStreamBuffer );
     }
     else
     {
         traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+    }
+
+    traceRETURN_uxStreamBufferReceiveMessages( uxReceived );
+
+    return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferGetReadSpan( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferVector_t pxSpans[ 2 ],
+                                 TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xBytesAvailable, xBytesToWaitFor;
+
+    traceENTER_xStreamBufferGetReadSpan( xStreamBuffer, pxSpans, xTicksToWait );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+
+    /* Message buffers interleave length fields with the data, so cannot be
+     * exposed as raw bytes. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BATCHING_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* As xStreamBufferReceive(), don't unblock until the trigger level is
+         * exceeded. */
+        xBytesToWaitFor = pxStreamBuffer->xTriggerLevelBytes;
+    }
+    else
+    {
+        xBytesToWaitFor = 0;
+    }
+
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToWaitFor, xTicksToWait );
+    prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, xBytesAvailable, pxSpans );
+
+    traceRETURN_xStreamBufferGetReadSpan( xBytesAvailable );
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xBytesConsumed )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xNextTail;
+
+    traceENTER_xStreamBufferConsume( xStreamBuffer, xBytesConsumed );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    /* Cannot release more than the reader was given. */
+    configASSERT( xBytesConsumed <= prvBytesInBuffer( pxStreamBuffer ) );
+
+    if( xBytesConsumed != ( size_t ) 0 )
+    {
+        xNextTail = pxStreamBuffer->xTail + xBytesConsumed;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xTail = xNextTail;
+
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesConsumed );
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    traceRETURN_xStreamBufferReceive( xReceivedLength );
+    traceRETURN_xStreamBufferConsume( xBytesConsumed );
 
-    return xReceivedLength;
+    return xBytesConsumed;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferGetWriteSpan( StreamBufferHandle_t xStreamBuffer,
+                                  StreamBufferVector_t pxSpans[ 2 ],
+                                  TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xSpace;
+
+    traceENTER_xStreamBufferGetWriteSpan( xStreamBuffer, pxSpans, xTicksToWait );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    xSpace = prvWaitForSpace( pxStreamBuffer, ( size_t ) 1, xTicksToWait );
+    prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, xSpace, pxSpans );
+
+    traceRETURN_xStreamBufferGetWriteSpan( xSpace );
+
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                            size_t xBytesWritten )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xNextHead;
+
+    traceENTER_xStreamBufferCommit( xStreamBuffer, xBytesWritten );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    /* Cannot publish more than the writer was given. */
+    configASSERT( xBytesWritten <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+    if( xBytesWritten != ( size_t ) 0 )
+    {
+        xNextHead = pxStreamBuffer->xHead + xBytesWritten;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xHead = xNextHead;
+
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xStreamBufferCommit( xBytesWritten );
+
+    return xBytesWritten;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                         size_t xIndex,
+                         size_t xCount,
+                         StreamBufferVector_t pxSpans[ 2 ] )
+{
+    size_t xFirstLength;
+
+    configASSERT( xIndex < pxStreamBuffer->xLength );
+
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xIndex, xCount );
+
+    pxSpans[ 0 ].pvData = &( pxStreamBuffer->pucBuffer[ xIndex ] );
+    pxSpans[ 0 ].xLength = xFirstLength;
+
+    /* Whatever did not fit before the end of the storage area continues from
+     * its start. */
+    pxSpans[ 1 ].pvData = pxStreamBuffer->pucBuffer;
+    pxSpans[ 1 ].xLength = xCount - xFirstLength;
 }
 /*-----------------------------------------------------------*/
 
@@ -277,6 +277,32 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+
+/* Value of ulReadyTime for a task that is ready because it was preempted or
+ * yielded, rather than because it was unblocked, so no latency is recorded when
+ * it next runs.  0 means the task is not waiting to run at all. */
+    #define taskREADY_TIME_NOT_WOKEN    ( ( configRUN_TIME_COUNTER_TYPE ) ~( ( configRUN_TIME_COUNTER_TYPE ) 0U ) )
+
+/* Timestamp a task that is being made ready.  A task that is already waiting
+ * to run, for example one whose priority changes, keeps its original time.
+ * Nothing is recorded before the scheduler starts, the run time counter is only
+ * configured then. */
+    #define taskRECORD_READY_TIME( pxTCB )                                     \
+    do {                                                                       \
+        if( ( ( pxTCB )->ulReadyTime == ( configRUN_TIME_COUNTER_TYPE ) 0U ) && \
+            ( xSchedulerRunning != pdFALSE ) )                                 \
+        {                                                                      \
+            ( pxTCB )->ulReadyTime = prvGetReadyTime();                        \
+        }                                                                      \
+    } while( 0 )
+
+    #define taskCLEAR_READY_TIME( pxTCB )    ( ( pxTCB )->ulReadyTime = ( configRUN_TIME_COUNTER_TYPE ) 0U )
+#else
+    #define taskRECORD_READY_TIME( pxTCB )
+    #define taskCLEAR_READY_TIME( pxTCB )
+#endif /* configUSE_SCHEDULING_LATENCY_HISTOGRAM */
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
@@ -284,6 +310,7 @@
 #define prvAddTaskToReadyList( pxTCB )                                                                     \
     do {                                                                                                   \
         traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+        taskRECORD_READY_TIME( pxTCB );                                                                    \
         taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
         listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
         tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
@@ -427,6 +454,11 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Stores the amount of time the task has spent in the Running state. */
     #endif
 
+    #if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+        configRUN_TIME_COUNTER_TYPE ulReadyTime;          /**< Run time counter value when the task was last made ready, see taskREADY_TIME_NOT_WOKEN. */
+        TaskLatencyHistogram_t xSchedulingLatency;        /**< Time from being made ready to being switched in. */
+    #endif
+
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         configTLS_BLOCK_TYPE xTLSBlock; /**< Memory block used as Thread Local Storage (TLS) Block for the task. */
     #endif
@@ -449,6 +481,15 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+        UBaseType_t uxSnapshotSlot; /**< Index of the task in pxTaskRegistry[]. */
+    #endif
+
+    #if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+        TaskHandle_t volatile * pxLightSyncWaiter; /**< The lightweight semaphore or event record that holds this task's handle while it waits on a notification, or NULL. */
+        UBaseType_t uxLightSyncNotifyIndex;        /**< The notification index it waits on. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -479,6 +520,35 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Po
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_DELAYED_LIST_INDEX == 1 )
+
+/* Insertion hints for xDelayedTaskList1 (row 0) and xDelayedTaskList2 (row 1),
+ * indexed by wake time.  Each slot remembers the latest waking item inserted
+ * into its range of ticks.  A hint is only used if the item is still in the
+ * list and does not wake after the item being inserted, so stale hints are
+ * harmless as long as they never point to freed memory. */
+    PRIVILEGED_DATA static ListItem_t * pxDelayedListHints[ 2 ][ configDELAYED_LIST_INDEX_SLOTS ];
+
+/* The number of slots below the wake time's own slot that are searched for a
+ * usable hint before falling back to the head of the list. */
+    #define taskDELAYED_LIST_HINT_PROBES    4U
+#endif
+
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+
+/* The last waiter inserted into each (event list, priority) pair, hashed by
+ * taskEVENT_LIST_TAIL_SLOT().  As with the delayed list hints, a tail is only
+ * used if it is still in the list and still has that priority, so a slot that
+ * was overwritten by another pair or went stale only costs a longer search.
+ * The tails live here rather than in each object so they can be cleared when
+ * a TCB is freed. */
+    PRIVILEGED_DATA static ListItem_t * pxEventListTails[ configEVENT_LIST_INDEX_SLOTS ];
+
+    #define taskEVENT_LIST_TAIL_SLOT( pxEventList, uxPriority ) \
+    ( ( ( ( portPOINTER_SIZE_TYPE ) ( pxEventList ) / ( portPOINTER_SIZE_TYPE ) sizeof( List_t ) ) + ( portPOINTER_SIZE_TYPE ) ( uxPriority ) ) & ( portPOINTER_SIZE_TYPE ) ( configEVENT_LIST_INDEX_SLOTS - 1U ) )
+
+#endif
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /**< Tasks that have been deleted - but their memory not yet freed. */
@@ -492,6 +562,22 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Ta
 
 #endif
 
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+/* Every task that exists, so uxTaskGetSystemSnapshot() can visit them without
+ * walking the state lists.  Slots are only changed, and only read, inside a
+ * critical section, and a task is removed before its TCB is freed. */
+    PRIVILEGED_DATA static TCB_t * pxTaskRegistry[ configTASK_SNAPSHOT_MAX_TASKS ];
+    PRIVILEGED_DATA static UBaseType_t uxTaskRegistryFreeSlots[ configTASK_SNAPSHOT_MAX_TASKS ]; /**< Stack of slots below uxTaskRegistryHighWater that are free again. */
+    PRIVILEGED_DATA static UBaseType_t uxTaskRegistryFreeCount = ( UBaseType_t ) 0U;
+    PRIVILEGED_DATA static UBaseType_t uxTaskRegistryHighWater = ( UBaseType_t ) 0U;             /**< Slots from here on have never been used. */
+    PRIVILEGED_DATA static UBaseType_t uxTaskRegistryMissed = ( UBaseType_t ) 0U;                /**< Tasks that exist without a slot. */
+
+/* uxSnapshotSlot of a task that did not fit in the registry. */
+    #define taskSNAPSHOT_NO_SLOT    ( ( UBaseType_t ) configTASK_SNAPSHOT_MAX_TASKS )
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
  * the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -631,6 +717,26 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Add a task to, or remove it from, the registry used by
+ * uxTaskGetSystemSnapshot().  Both must be called from a critical section.
+ */
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    static void prvRegisterTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvUnregisterTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Removes a task that is being deleted or suspended from the lightweight
+ * semaphore or event it waits on, so gives go to other tasks.  Must be called
+ * from a critical section.
+ */
+#if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+    static void prvDropLightSyncWaiter( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
  * either the current or the overflow delayed task list.
@@ -638,6 +744,33 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * Insert pxListItem into pxEventList in priority order, starting the search
+ * from the last waiter of the nearest priority at or above its own that
+ * pxIndex and pxEventListTails[] know of.
+ */
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+    static void prvInsertIntoEventList( List_t * const pxEventList,
+                                        EventListIndex_t * const pxIndex,
+                                        ListItem_t * const pxListItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * The index of the lowest set bit of a non-zero ulBits.
+ */
+    static UBaseType_t prvLowestSetBit( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Insert pxListItem into one of the delayed task lists in wake time order.
+ * Uses the delayed list index when configUSE_DELAYED_LIST_INDEX is 1.
+ */
+#if ( configUSE_DELAYED_LIST_INDEX == 1 )
+    static void prvInsertIntoDelayedList( List_t * const pxList,
+                                          ListItem_t * const pxListItem ) PRIVILEGED_FUNCTION;
+#else
+    #define prvInsertIntoDelayedList( pxList, pxListItem )    vListInsert( ( pxList ), ( pxListItem ) )
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -672,7 +805,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    static configSTACK_DEPTH_TYPE prvTaskGetFreeStackSpace( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -728,6 +861,30 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+
+/*
+ * Returns the run time counter value to store in ulReadyTime, adjusted so it is
+ * never 0 or taskREADY_TIME_NOT_WOKEN.
+ */
+    static configRUN_TIME_COUNTER_TYPE prvGetReadyTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from vTaskSwitchContext() for the task being switched out and then for
+ * the task being switched in, ulNow being the time of the switch.  The latter
+ * adds the time since the task was made ready to its histogram.
+ */
+    static void prvSchedulingLatencySwitchedOut( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvSchedulingLatencySwitchedIn( TCB_t * pxTCB,
+                                                configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Maps a latency to its histogram bucket.
+ */
+    static UBaseType_t prvSchedulingLatencyBucket( configRUN_TIME_COUNTER_TYPE ulLatency ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_SCHEDULING_LATENCY_HISTOGRAM */
+
 /*
  * Create a task with static buffer for both TCB and stack. Returns a handle to
  * the task if it is created successfully. Otherwise, returns NULL.
@@ -1648,6 +1805,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     {
         TCB_t * pxNewTCB;
 
+        /* Ports whose tasks run on a stack of their own only need part of the
+         * requested depth from the kernel. */
+        const configSTACK_DEPTH_TYPE uxAllocatedDepth = portTASK_STACK_DEPTH( uxStackDepth );
+
         /* If the stack grows down then allocate the stack then the TCB so the stack
          * does not grow into the TCB.  Likewise if the stack grows up then allocate
          * the TCB then the stack. */
@@ -1671,7 +1832,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* MISRA Ref 11.5.1 [Malloc memory assignment] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                 /* coverity[misra_c_2012_rule_11_5_violation] */
-                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
+                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) uxAllocatedDepth ) * sizeof( StackType_t ) ) );
 
                 if( pxNewTCB->pxStack == NULL )
                 {
@@ -1689,7 +1850,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxStack = pvPortMallocStack( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
+            pxStack = pvPortMallocStack( ( ( ( size_t ) uxAllocatedDepth ) * sizeof( StackType_t ) ) );
 
             if( pxStack != NULL )
             {
@@ -1730,7 +1891,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            prvInitialiseNewTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+            prvInitialiseNewTask( pxTaskCode, pcName, uxAllocatedDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
         }
 
         return pxNewTCB;
@@ -2046,6 +2207,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         {
             uxCurrentNumberOfTasks = ( UBaseType_t ) ( uxCurrentNumberOfTasks + 1U );
 
+            #if ( configUSE_TASK_SNAPSHOT == 1 )
+            {
+                prvRegisterTask( pxNewTCB );
+            }
+            #endif
+
             if( pxCurrentTCB == NULL )
             {
                 /* There are no other tasks, or all the other tasks are in
@@ -2124,6 +2291,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         {
             uxCurrentNumberOfTasks++;
 
+            #if ( configUSE_TASK_SNAPSHOT == 1 )
+            {
+                prvRegisterTask( pxNewTCB );
+            }
+            #endif
+
             if( xSchedulerRunning == pdFALSE )
             {
                 if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
@@ -2245,6 +2418,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+            {
+                prvDropLightSyncWaiter( pxTCB );
+            }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -3161,6 +3340,9 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
             traceTASK_SUSPEND( pxTCB );
 
+            /* A ready task that is suspended is no longer waiting to run. */
+            taskCLEAR_READY_TIME( pxTCB );
+
             /* Remove task from the ready/delayed list and place in the
              * suspended list. */
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -3200,6 +3382,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             }
             #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 
+            #if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+            {
+                prvDropLightSyncWaiter( pxTCB );
+            }
+            #endif
+
             /* In the case of SMP, it is possible that the task being suspended
              * is running on another core. We must evict the task before
              * exiting the critical section to ensure that the task cannot
@@ -3509,6 +3697,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                      * is held in the pending ready list until the scheduler is
                      * unsuspended. */
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    taskRECORD_READY_TIME( pxTCB );
                 }
 
                 #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
@@ -3964,14 +4153,16 @@ void vTaskSuspendAll( void )
         }
         #else
         {
-            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+            UBaseType_t uxTopPriority;
 
             /* When port optimised task selection is used the uxTopReadyPriority
-             * variable is used as a bit map.  If bits other than the least
-             * significant bit are set then there are tasks that have a priority
-             * above the idle priority that are in the Ready state.  This takes
-             * care of the case where the co-operative scheduler is in use. */
-            if( uxTopReadyPriority > uxLeastSignificantBit )
+             * variable is a bit map whose layout is port specific, so ask the
+             * port for the highest ready priority rather than interpreting the
+             * bits here.  This takes care of the case where the co-operative
+             * scheduler is in use. */
+            portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+
+            if( uxTopPriority > tskIDLE_PRIORITY )
             {
                 xHigherPriorityReadyTasks = pdTRUE;
             }
@@ -4514,6 +4705,135 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+
+    static void prvRegisterTask( TCB_t * pxTCB )
+    {
+        UBaseType_t uxSlot = taskSNAPSHOT_NO_SLOT;
+
+        if( uxTaskRegistryFreeCount > ( UBaseType_t ) 0U )
+        {
+            uxTaskRegistryFreeCount--;
+            uxSlot = uxTaskRegistryFreeSlots[ uxTaskRegistryFreeCount ];
+        }
+        else if( uxTaskRegistryHighWater < ( UBaseType_t ) configTASK_SNAPSHOT_MAX_TASKS )
+        {
+            uxSlot = uxTaskRegistryHighWater;
+            uxTaskRegistryHighWater++;
+        }
+        else
+        {
+            /* The registry is full.  The task works normally but is left out
+             * of snapshots, which uxTaskGetSnapshotMissedTasks() reports. */
+            uxTaskRegistryMissed++;
+        }
+
+        if( uxSlot != taskSNAPSHOT_NO_SLOT )
+        {
+            pxTaskRegistry[ uxSlot ] = pxTCB;
+        }
+
+        pxTCB->uxSnapshotSlot = uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUnregisterTask( TCB_t * pxTCB )
+    {
+        const UBaseType_t uxSlot = pxTCB->uxSnapshotSlot;
+
+        if( uxSlot != taskSNAPSHOT_NO_SLOT )
+        {
+            pxTaskRegistry[ uxSlot ] = NULL;
+            uxTaskRegistryFreeSlots[ uxTaskRegistryFreeCount ] = uxSlot;
+            uxTaskRegistryFreeCount++;
+            pxTCB->uxSnapshotSlot = taskSNAPSHOT_NO_SLOT;
+        }
+        else
+        {
+            configASSERT( uxTaskRegistryMissed > ( UBaseType_t ) 0U );
+            uxTaskRegistryMissed--;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetSystemSnapshot( TaskStatus_t * const pxTaskStatusArray,
+                                         const UBaseType_t uxArraySize,
+                                         configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxTask = 0, uxSlot;
+        TCB_t * pxTCB;
+
+        traceENTER_uxTaskGetSystemSnapshot( pxTaskStatusArray, uxArraySize, pulTotalRunTime );
+
+        configASSERT( ( pxTaskStatusArray != NULL ) || ( uxArraySize == ( UBaseType_t ) 0U ) );
+
+        /* Unlike uxTaskGetSystemState() the scheduler keeps running: each task
+         * is read in its own short critical section, so the worst case
+         * interrupt and scheduling latency added is that of one task, not of
+         * all of them.  The price is that the result is not an instant in
+         * time - tasks can change state, or be created or deleted, between
+         * one slot and the next. */
+        for( uxSlot = 0U; ( uxSlot < uxTaskRegistryHighWater ) && ( uxTask < uxArraySize ); uxSlot++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxTCB = pxTaskRegistry[ uxSlot ];
+
+                if( pxTCB != NULL )
+                {
+                    /* eInvalid makes vTaskGetInfo() work the state out, the
+                     * stack is not scanned as that is not a constant time
+                     * operation. */
+                    vTaskGetInfo( pxTCB, &( pxTaskStatusArray[ uxTask ] ), pdFALSE, eInvalid );
+                    uxTask++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( pulTotalRunTime != NULL )
+        {
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                #else
+                    *pulTotalRunTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+            #else
+                *pulTotalRunTime = 0;
+            #endif
+        }
+
+        traceRETURN_uxTaskGetSystemSnapshot( uxTask );
+
+        return uxTask;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetSnapshotMissedTasks( void )
+    {
+        UBaseType_t uxMissedTasks;
+
+        traceENTER_uxTaskGetSnapshotMissedTasks();
+
+        taskENTER_CRITICAL();
+        {
+            uxMissedTasks = uxTaskRegistryMissed;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_uxTaskGetSnapshotMissedTasks( uxMissedTasks );
+
+        return uxMissedTasks;
+    }
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -5149,6 +5469,12 @@ BaseType_t xTaskIncrementTick( void )
             }
             #endif /* configGENERATE_RUN_TIME_STATS */
 
+            #if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+            {
+                prvSchedulingLatencySwitchedOut( pxCurrentTCB );
+            }
+            #endif
+
             /* Check for stack overflow, if configured. */
             taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -5167,6 +5493,12 @@ BaseType_t xTaskIncrementTick( void )
             taskSELECT_HIGHEST_PRIORITY_TASK();
             traceTASK_SWITCHED_IN();
 
+            #if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+            {
+                prvSchedulingLatencySwitchedIn( pxCurrentTCB, ulTotalRunTime[ 0 ] );
+            }
+            #endif
+
             /* Macro to inject port specific behaviour immediately after
              * switching tasks, such as setting an end of stack watchpoint
              * or reconfiguring the MPU. */
@@ -5250,6 +5582,12 @@ BaseType_t xTaskIncrementTick( void )
                 }
                 #endif /* configGENERATE_RUN_TIME_STATS */
 
+                #if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+                {
+                    prvSchedulingLatencySwitchedOut( pxCurrentTCBs[ xCoreID ] );
+                }
+                #endif
+
                 /* Check for stack overflow, if configured. */
                 taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -5264,6 +5602,12 @@ BaseType_t xTaskIncrementTick( void )
                 taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
                 traceTASK_SWITCHED_IN();
 
+                #if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+                {
+                    prvSchedulingLatencySwitchedIn( pxCurrentTCBs[ xCoreID ], ulTotalRunTime[ xCoreID ] );
+                }
+                #endif
+
                 /* Macro to inject port specific behaviour immediately after
                  * switching tasks, such as setting an end of stack watchpoint
                  * or reconfiguring the MPU. */
@@ -5322,6 +5666,29 @@ void vTaskPlaceOnEventList( List_t * const pxEventList,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+
+    void vTaskPlaceOnIndexedEventList( List_t * const pxEventList,
+                                       EventListIndex_t * const pxIndex,
+                                       const TickType_t xTicksToWait )
+    {
+        traceENTER_vTaskPlaceOnIndexedEventList( pxEventList, pxIndex, xTicksToWait );
+
+        configASSERT( pxEventList );
+        configASSERT( pxIndex );
+
+        /* As vTaskPlaceOnEventList(), so THIS FUNCTION MUST BE CALLED WITH THE
+         * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+        prvInsertIntoEventList( pxEventList, pxIndex, &( pxCurrentTCB->xEventListItem ) );
+
+        prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+
+        traceRETURN_vTaskPlaceOnIndexedEventList();
+    }
+
+#endif /* configUSE_EVENT_LIST_INDEX */
+/*-----------------------------------------------------------*/
+
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
                                      const TickType_t xItemValue,
                                      const TickType_t xTicksToWait )
@@ -5440,8 +5807,10 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     else
     {
         /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
+         * pending until the scheduler is resumed.  Its wait to run starts now
+         * though, not when it is moved to a ready list. */
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+        taskRECORD_READY_TIME( pxUnblockedTCB );
     }
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -6299,15 +6668,7 @@ static void prvCheckTasksWaitingTermination( void )
          * parameter is provided to allow it to be skipped. */
         if( xGetFreeStackSpace != pdFALSE )
         {
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-            }
-            #else
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-            }
-            #endif
+            pxTaskStatus->usStackHighWaterMark = prvTaskGetFreeStackSpace( pxTCB );
         }
         else
         {
@@ -6361,17 +6722,39 @@ static void prvCheckTasksWaitingTermination( void )
 
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static configSTACK_DEPTH_TYPE prvTaskGetFreeStackSpace( const TCB_t * pxTCB )
     {
         configSTACK_DEPTH_TYPE uxCount = 0U;
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        #ifdef portGET_STACK_HIGH_WATER_MARK
         {
-            pucStackByte -= portSTACK_GROWTH;
-            uxCount++;
+            /* The task does not run on pxStack, so ask the port how much of
+             * the stack it really runs on has never been used. */
+            uxCount = ( configSTACK_DEPTH_TYPE ) portGET_STACK_HIGH_WATER_MARK( pxTCB );
         }
+        #else
+        {
+            const uint8_t * pucStackByte;
+
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                pucStackByte = ( const uint8_t * ) pxTCB->pxStack;
+            }
+            #else
+            {
+                pucStackByte = ( const uint8_t * ) pxTCB->pxEndOfStack;
+            }
+            #endif
+
+            while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+            {
+                pucStackByte -= portSTACK_GROWTH;
+                uxCount++;
+            }
 
-        uxCount /= ( configSTACK_DEPTH_TYPE ) sizeof( StackType_t );
+            uxCount /= ( configSTACK_DEPTH_TYPE ) sizeof( StackType_t );
+        }
+        #endif /* portGET_STACK_HIGH_WATER_MARK */
 
         return uxCount;
     }
@@ -6389,7 +6772,6 @@ static void prvCheckTasksWaitingTermination( void )
     configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         configSTACK_DEPTH_TYPE uxReturn;
 
         traceENTER_uxTaskGetStackHighWaterMark2( xTask );
@@ -6404,17 +6786,7 @@ static void prvCheckTasksWaitingTermination( void )
         pxTCB = prvGetTCBFromHandle( xTask );
         configASSERT( pxTCB != NULL );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
-
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+        uxReturn = prvTaskGetFreeStackSpace( pxTCB );
 
         traceRETURN_uxTaskGetStackHighWaterMark2( uxReturn );
 
@@ -6429,7 +6801,6 @@ static void prvCheckTasksWaitingTermination( void )
     UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         UBaseType_t uxReturn;
 
         traceENTER_uxTaskGetStackHighWaterMark( xTask );
@@ -6437,17 +6808,7 @@ static void prvCheckTasksWaitingTermination( void )
         pxTCB = prvGetTCBFromHandle( xTask );
         configASSERT( pxTCB != NULL );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
-
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+        uxReturn = ( UBaseType_t ) prvTaskGetFreeStackSpace( pxTCB );
 
         traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
 
@@ -6466,6 +6827,51 @@ static void prvCheckTasksWaitingTermination( void )
          * want to allocate and clean RAM statically. */
         portCLEAN_UP_TCB( pxTCB );
 
+        #if ( configUSE_TASK_SNAPSHOT == 1 )
+        {
+            /* A snapshot in progress must not see the TCB once it is freed. */
+            taskENTER_CRITICAL();
+            {
+                prvUnregisterTask( pxTCB );
+            }
+            taskEXIT_CRITICAL();
+        }
+        #endif
+
+        #if ( configUSE_EVENT_LIST_INDEX == 1 )
+        {
+            UBaseType_t uxSlot;
+
+            /* The TCB is about to be freed, so it must not remain a tail. */
+            for( uxSlot = 0U; uxSlot < configEVENT_LIST_INDEX_SLOTS; uxSlot++ )
+            {
+                if( pxEventListTails[ uxSlot ] == &( pxTCB->xEventListItem ) )
+                {
+                    pxEventListTails[ uxSlot ] = NULL;
+                }
+            }
+        }
+        #endif
+
+        #if ( configUSE_DELAYED_LIST_INDEX == 1 )
+        {
+            UBaseType_t uxList;
+            UBaseType_t uxSlot;
+
+            /* The TCB is about to be freed, so it must not remain a hint. */
+            for( uxList = 0U; uxList < 2U; uxList++ )
+            {
+                for( uxSlot = 0U; uxSlot < configDELAYED_LIST_INDEX_SLOTS; uxSlot++ )
+                {
+                    if( pxDelayedListHints[ uxList ][ uxSlot ] == &( pxTCB->xStateListItem ) )
+                    {
+                        pxDelayedListHints[ uxList ][ uxSlot ] = NULL;
+                    }
+                }
+            }
+        }
+        #endif
+
         #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         {
             /* Free up the memory allocated for the task's TLS Block. */
@@ -7661,6 +8067,61 @@ TickType_t uxTaskResetEventItemValue( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_LIGHTWEIGHT_SYNC == 1 )
+
+    void vTaskSetLightSyncWaiter( TaskHandle_t volatile * pxWaiterRecord,
+                                  UBaseType_t uxIndexToWaitOn )
+    {
+        traceENTER_vTaskSetLightSyncWaiter( pxWaiterRecord, uxIndexToWaitOn );
+
+        configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        pxCurrentTCB->pxLightSyncWaiter = pxWaiterRecord;
+        pxCurrentTCB->uxLightSyncNotifyIndex = uxIndexToWaitOn;
+
+        traceRETURN_vTaskSetLightSyncWaiter();
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t volatile * pxTaskGetLightSyncWaiter( void )
+    {
+        TaskHandle_t volatile * pxReturn;
+
+        traceENTER_pxTaskGetLightSyncWaiter();
+
+        pxReturn = pxCurrentTCB->pxLightSyncWaiter;
+
+        traceRETURN_pxTaskGetLightSyncWaiter( pxReturn );
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDropLightSyncWaiter( TCB_t * pxTCB )
+    {
+        TaskHandle_t volatile * const pxWaiterRecord = pxTCB->pxLightSyncWaiter;
+
+        /* The record no longer holds this task once the task has been given
+         * the count or the event, in which case there is nothing to drop. */
+        if( ( pxWaiterRecord != NULL ) && ( *pxWaiterRecord == pxTCB ) )
+        {
+            *pxWaiterRecord = NULL;
+            pxTCB->pxLightSyncWaiter = NULL;
+
+            /* If the task is suspended before it blocks on the notification,
+             * make that wait return at once when the task is resumed, so it
+             * sees it was dropped and waits again. */
+            pxTCB->ucNotifyState[ pxTCB->uxLightSyncNotifyIndex ] = taskNOTIFICATION_RECEIVED;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_LIGHTWEIGHT_SYNC */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
     TaskHandle_t pvTaskIncrementMutexHeldCount( void )
@@ -8152,6 +8613,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    taskRECORD_READY_TIME( pxTCB );
                 }
 
                 #if ( configNUMBER_OF_CORES == 1 )
@@ -8286,6 +8748,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    taskRECORD_READY_TIME( pxTCB );
                 }
 
                 #if ( configNUMBER_OF_CORES == 1 )
@@ -8576,6 +9039,239 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvGetReadyTime( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTime;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime );
+        #else
+            ulTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* 0 and the all ones value are reserved, being one count out does not
+         * matter. */
+        if( ( ulTime == ( configRUN_TIME_COUNTER_TYPE ) 0U ) || ( ulTime == taskREADY_TIME_NOT_WOKEN ) )
+        {
+            ulTime = ( configRUN_TIME_COUNTER_TYPE ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ulTime;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvSchedulingLatencyBucket( configRUN_TIME_COUNTER_TYPE ulLatency )
+    {
+        const configRUN_TIME_COUNTER_TYPE ulSubBuckets = ( configRUN_TIME_COUNTER_TYPE ) 1U << configSCHEDULING_LATENCY_SUB_BUCKET_BITS;
+        UBaseType_t uxShift = 0U;
+        UBaseType_t uxBucket;
+
+        /* Find the shift that leaves configSCHEDULING_LATENCY_SUB_BUCKET_BITS + 1
+         * significant bits.  The top one selects the power of two range and the
+         * rest the sub-bucket within it, so the buckets of consecutive ranges
+         * follow on from each other and latencies below 2 * ulSubBuckets get a
+         * bucket each. */
+        while( ( ulLatency >> uxShift ) >= ( ulSubBuckets << 1U ) )
+        {
+            uxShift++;
+        }
+
+        uxBucket = ( uxShift << configSCHEDULING_LATENCY_SUB_BUCKET_BITS ) + ( UBaseType_t ) ( ulLatency >> uxShift );
+
+        if( uxBucket >= ( UBaseType_t ) tskSCHEDULING_LATENCY_BUCKETS )
+        {
+            uxBucket = ( UBaseType_t ) tskSCHEDULING_LATENCY_BUCKETS - 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSchedulingLatencySwitchedOut( TCB_t * pxTCB )
+    {
+        /* A task that is switched out while still in its ready list was
+         * preempted or yielded.  Mark it so the time until it next runs is not
+         * taken as a wake up latency, even if its priority changes meanwhile. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            pxTCB->ulReadyTime = taskREADY_TIME_NOT_WOKEN;
+        }
+        else
+        {
+            pxTCB->ulReadyTime = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSchedulingLatencySwitchedIn( TCB_t * pxTCB,
+                                                configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        TaskLatencyHistogram_t * const pxHistogram = &( pxTCB->xSchedulingLatency );
+        configRUN_TIME_COUNTER_TYPE ulLatency;
+
+        /* The last check guards against a run time counter that is not
+         * monotonic, or is not synchronised between cores. */
+        if( ( pxTCB->ulReadyTime != ( configRUN_TIME_COUNTER_TYPE ) 0U ) &&
+            ( pxTCB->ulReadyTime != taskREADY_TIME_NOT_WOKEN ) &&
+            ( ulNow >= pxTCB->ulReadyTime ) )
+        {
+            ulLatency = ulNow - pxTCB->ulReadyTime;
+
+            if( ( pxHistogram->ulSamples == ( configRUN_TIME_COUNTER_TYPE ) 0U ) || ( ulLatency < pxHistogram->ulMin ) )
+            {
+                pxHistogram->ulMin = ulLatency;
+            }
+
+            if( ulLatency > pxHistogram->ulMax )
+            {
+                pxHistogram->ulMax = ulLatency;
+            }
+
+            pxHistogram->ulSamples++;
+            pxHistogram->ulTotal += ulLatency;
+            pxHistogram->ulBuckets[ prvSchedulingLatencyBucket( ulLatency ) ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->ulReadyTime = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetSchedulingLatency( TaskHandle_t xTask,
+                                    TaskLatencyHistogram_t * pxHistogram )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskGetSchedulingLatency( xTask, pxHistogram );
+
+        configASSERT( pxHistogram != NULL );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        /* The histogram is updated by context switches, take a consistent
+         * copy. */
+        taskENTER_CRITICAL();
+        {
+            ( void ) memcpy( pxHistogram, &( pxTCB->xSchedulingLatency ), sizeof( TaskLatencyHistogram_t ) );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskGetSchedulingLatency();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskResetSchedulingLatency( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskResetSchedulingLatency( xTask );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( pxTCB->xSchedulingLatency ), 0x00, sizeof( TaskLatencyHistogram_t ) );
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskResetSchedulingLatency();
+    }
+/*-----------------------------------------------------------*/
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetSchedulingLatencyBucketValue( UBaseType_t uxBucket )
+    {
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+        UBaseType_t uxShift;
+
+        traceENTER_ulTaskGetSchedulingLatencyBucketValue( uxBucket );
+
+        configASSERT( uxBucket < ( UBaseType_t ) tskSCHEDULING_LATENCY_BUCKETS );
+
+        /* Inverse of prvSchedulingLatencyBucket(). */
+        uxShift = uxBucket >> configSCHEDULING_LATENCY_SUB_BUCKET_BITS;
+
+        if( uxShift == 0U )
+        {
+            ulReturn = ( configRUN_TIME_COUNTER_TYPE ) uxBucket;
+        }
+        else
+        {
+            uxShift--;
+            ulReturn = ( configRUN_TIME_COUNTER_TYPE ) ( uxBucket - ( uxShift << configSCHEDULING_LATENCY_SUB_BUCKET_BITS ) ) << uxShift;
+        }
+
+        traceRETURN_ulTaskGetSchedulingLatencyBucketValue( ulReturn );
+
+        return ulReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetSchedulingLatencyPercentile( const TaskLatencyHistogram_t * pxHistogram,
+                                                                      UBaseType_t uxPercentile )
+    {
+        configRUN_TIME_COUNTER_TYPE ulReturn = 0U;
+        configRUN_TIME_COUNTER_TYPE ulTarget, ulSeen = 0U;
+        UBaseType_t uxBucket;
+
+        traceENTER_ulTaskGetSchedulingLatencyPercentile( pxHistogram, uxPercentile );
+
+        configASSERT( pxHistogram != NULL );
+        configASSERT( uxPercentile <= 100U );
+
+        if( pxHistogram->ulSamples > ( configRUN_TIME_COUNTER_TYPE ) 0U )
+        {
+            /* Rank of the sample at the percentile, rounded up, at least 1. */
+            ulTarget = ( ( pxHistogram->ulSamples * ( configRUN_TIME_COUNTER_TYPE ) uxPercentile ) + 99U ) / 100U;
+            ulTarget = ( ulTarget == ( configRUN_TIME_COUNTER_TYPE ) 0U ) ? ( configRUN_TIME_COUNTER_TYPE ) 1U : ulTarget;
+            ulReturn = pxHistogram->ulMax;
+
+            for( uxBucket = 0U; uxBucket < ( UBaseType_t ) tskSCHEDULING_LATENCY_BUCKETS; uxBucket++ )
+            {
+                ulSeen += pxHistogram->ulBuckets[ uxBucket ];
+
+                if( ulSeen >= ulTarget )
+                {
+                    /* Report the highest value the bucket can hold, so the
+                     * result is never below the real percentile, but not
+                     * above the largest latency seen. */
+                    if( ( uxBucket + 1U ) < ( UBaseType_t ) tskSCHEDULING_LATENCY_BUCKETS )
+                    {
+                        ulReturn = ulTaskGetSchedulingLatencyBucketValue( uxBucket + 1U ) - 1U;
+                    }
+
+                    if( ulReturn > pxHistogram->ulMax )
+                    {
+                        ulReturn = pxHistogram->ulMax;
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        traceRETURN_ulTaskGetSchedulingLatencyPercentile( ulReturn );
+
+        return ulReturn;
+    }
+
+#endif /* configUSE_SCHEDULING_LATENCY_HISTOGRAM */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
@@ -8630,14 +9326,14 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
                 traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-                vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                prvInsertIntoDelayedList( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
                 traceMOVED_TASK_TO_DELAYED_LIST();
-                vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                prvInsertIntoDelayedList( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -8667,13 +9363,13 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         {
             traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            prvInsertIntoDelayedList( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
         }
         else
         {
             traceMOVED_TASK_TO_DELAYED_LIST();
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            prvInsertIntoDelayedList( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -8695,6 +9391,153 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_LIST_INDEX == 1 )
+
+    static void prvInsertIntoDelayedList( List_t * const pxList,
+                                          ListItem_t * const pxListItem )
+    {
+        ListItem_t ** const ppxHints = pxDelayedListHints[ ( pxList == &xDelayedTaskList1 ) ? 0 : 1 ];
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+        const UBaseType_t uxSlot = ( UBaseType_t ) ( xTimeToWake >> configDELAYED_LIST_INDEX_SHIFT ) & ( configDELAYED_LIST_INDEX_SLOTS - 1U );
+        ListItem_t * pxStart = ( ListItem_t * ) &( pxList->xListEnd );
+        ListItem_t * pxHint;
+        UBaseType_t uxProbe;
+
+        /* Start from the nearest hint that wakes no later than this item.  The
+         * search then only walks the tasks that wake between the two. */
+        for( uxProbe = 0U; uxProbe < taskDELAYED_LIST_HINT_PROBES; uxProbe++ )
+        {
+            pxHint = ppxHints[ ( uxSlot - uxProbe ) & ( configDELAYED_LIST_INDEX_SLOTS - 1U ) ];
+
+            if( ( pxHint != NULL ) &&
+                ( listLIST_ITEM_CONTAINER( pxHint ) == pxList ) &&
+                ( listGET_LIST_ITEM_VALUE( pxHint ) <= xTimeToWake ) )
+            {
+                pxStart = pxHint;
+                break;
+            }
+        }
+
+        vListInsertFrom( pxList, pxStart, pxListItem );
+
+        /* Keep the latest waking item of the slot as its hint. */
+        pxHint = ppxHints[ uxSlot ];
+
+        if( ( pxHint == NULL ) ||
+            ( listLIST_ITEM_CONTAINER( pxHint ) != pxList ) ||
+            ( listGET_LIST_ITEM_VALUE( pxHint ) <= xTimeToWake ) )
+        {
+            ppxHints[ uxSlot ] = pxListItem;
+        }
+    }
+
+#endif /* configUSE_DELAYED_LIST_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_LIST_INDEX == 1 )
+
+    static void prvInsertIntoEventList( List_t * const pxEventList,
+                                        EventListIndex_t * const pxIndex,
+                                        ListItem_t * const pxListItem )
+    {
+        const TickType_t xItemValue = listGET_LIST_ITEM_VALUE( pxListItem );
+        ListItem_t * pxStart = ( ListItem_t * ) &( pxEventList->xListEnd );
+        ListItem_t * pxTail;
+        UBaseType_t uxPriority;
+        UBaseType_t uxGroup;
+        UBaseType_t uxWord;
+        uint32_t ulBits;
+
+        if( ( xItemValue == ( TickType_t ) 0 ) || ( xItemValue > ( TickType_t ) configMAX_PRIORITIES ) )
+        {
+            /* The value does not hold a priority, so there is nothing to
+             * index it by. */
+            vListInsert( pxEventList, pxListItem );
+        }
+        else
+        {
+            uxPriority = ( UBaseType_t ) ( ( TickType_t ) configMAX_PRIORITIES - xItemValue );
+
+            /* Bits are only cleared lazily, so drop them all whenever the
+             * list has drained. */
+            if( listLIST_IS_EMPTY( pxEventList ) != pdFALSE )
+            {
+                for( uxWord = 0U; uxWord < taskEVENT_LIST_INDEX_WORDS; uxWord++ )
+                {
+                    pxIndex->ulOccupiedPriorities[ uxWord ] = 0U;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Waiters are sorted highest priority first, so the item goes
+             * after the last waiter of the lowest priority that is still at
+             * or above its own.  Look for it from the item's own priority
+             * upwards. */
+            uxWord = uxPriority / 32U;
+            ulBits = pxIndex->ulOccupiedPriorities[ uxWord ] & ( ~( uint32_t ) 0U << ( uxPriority % 32U ) );
+
+            for( ; ; )
+            {
+                while( ( ulBits == 0U ) && ( uxWord < ( taskEVENT_LIST_INDEX_WORDS - 1U ) ) )
+                {
+                    uxWord++;
+                    ulBits = pxIndex->ulOccupiedPriorities[ uxWord ];
+                }
+
+                if( ulBits == 0U )
+                {
+                    /* No waiter of equal or higher priority is known of. */
+                    break;
+                }
+
+                uxGroup = ( uxWord * 32U ) + prvLowestSetBit( ulBits );
+                pxTail = pxEventListTails[ taskEVENT_LIST_TAIL_SLOT( pxEventList, uxGroup ) ];
+
+                if( ( pxTail != NULL ) &&
+                    ( listLIST_ITEM_CONTAINER( pxTail ) == pxEventList ) &&
+                    ( listGET_LIST_ITEM_VALUE( pxTail ) == ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxGroup ) ) )
+                {
+                    pxStart = pxTail;
+                    break;
+                }
+
+                /* The priority has no usable tail, because its last waiter
+                 * left or its slot was taken by another list.  Forget it.
+                 * Any waiters it still has are walked past by the search
+                 * below, which is slower but still puts the item in the
+                 * right place, and the next waiter of that priority sets
+                 * the bit again. */
+                pxIndex->ulOccupiedPriorities[ uxWord ] &= ~( ( uint32_t ) 1U << ( uxGroup % 32U ) );
+                ulBits &= ulBits - 1U;
+            }
+
+            vListInsertFrom( pxEventList, pxStart, pxListItem );
+
+            pxIndex->ulOccupiedPriorities[ uxPriority / 32U ] |= ( uint32_t ) 1U << ( uxPriority % 32U );
+            pxEventListTails[ taskEVENT_LIST_TAIL_SLOT( pxEventList, uxPriority ) ] = pxListItem;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvLowestSetBit( uint32_t ulBits )
+    {
+        static const uint8_t ucDeBruijnPositions[ 32 ] =
+        {
+            0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,  8U,
+            31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U
+        };
+
+        /* Isolate the lowest set bit, then a de Bruijn multiply turns it into
+         * a unique 5 bit table index. */
+        return ( UBaseType_t ) ucDeBruijnPositions[ ( uint32_t ) ( ( ulBits & ( ~ulBits + 1U ) ) * 0x077CB531U ) >> 27 ];
+    }
+
+#endif /* configUSE_EVENT_LIST_INDEX */
+/*-----------------------------------------------------------*/
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
     xMPU_SETTINGS * xTaskGetMPUSettings( TaskHandle_t xTask )
@@ -8835,6 +9678,14 @@ void vTaskResetState( void )
     xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
     uxTopReadyPriority = tskIDLE_PRIORITY;
     xSchedulerRunning = pdFALSE;
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+    {
+        /* The port may keep ready priorities beyond uxTopReadyPriority. */
+        portRESET_ALL_READY_PRIORITIES( uxTopReadyPriority );
+    }
+    #endif
+
     xPendedTicks = ( TickType_t ) 0U;
 
     for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
@@ -8848,6 +9699,21 @@ void vTaskResetState( void )
 
     uxSchedulerSuspended = ( UBaseType_t ) 0U;
 
+    #if ( configUSE_EVENT_LIST_INDEX == 1 )
+    {
+        ( void ) memset( ( void * ) pxEventListTails, 0x00, sizeof( pxEventListTails ) );
+    }
+    #endif /* #if ( configUSE_EVENT_LIST_INDEX == 1 ) */
+
+    #if ( configUSE_TASK_SNAPSHOT == 1 )
+    {
+        ( void ) memset( ( void * ) pxTaskRegistry, 0x00, sizeof( pxTaskRegistry ) );
+        uxTaskRegistryFreeCount = ( UBaseType_t ) 0U;
+        uxTaskRegistryHighWater = ( UBaseType_t ) 0U;
+        uxTaskRegistryMissed = ( UBaseType_t ) 0U;
+    }
+    #endif /* #if ( configUSE_TASK_SNAPSHOT == 1 ) */
+
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
     {
         for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
@@ -79,6 +79,12 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( 0x02U )
     #define tmrSTATUS_IS_AUTORELOAD              ( 0x04U )
 
+/* Bit definitions used in the ucPendingStatus member of a timer structure.
+ * Unlike ucStatus these are also written by the tasks and interrupts that
+ * submit resets, so they are only accessed from critical sections. */
+    #define tmrPENDING_IS_LINKED                 ( 0x01U )
+    #define tmrPENDING_RESET                     ( 0x02U )
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                                               /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -91,6 +97,11 @@
             UBaseType_t uxTimerNumber;                                           /**< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
         uint8_t ucStatus;                                                        /**< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+        #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+            uint8_t ucPendingStatus;                                             /**< Holds bits to say if the timer is on the list of pending resets, and if a reset is waiting to be applied. */
+            struct tmrTimerControl * pxNextPending;                              /**< The next timer on the list of pending resets. */
+            TickType_t xPendingCommandTime;                                      /**< The command time of the pending reset. */
+        #endif
     } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -145,10 +156,41 @@
     PRIVILEGED_DATA static List_t * pxCurrentTimerList;
     PRIVILEGED_DATA static List_t * pxOverflowTimerList;
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* Each level of the timer wheel has 32 slots so its occupancy fits in one
+ * uint32_t bitmap.  Enough levels are used to cover the full tick range. */
+        #define tmrWHEEL_SLOT_BITS    ( 5U )
+        #define tmrWHEEL_SLOTS        ( 1U << tmrWHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK    ( ( TickType_t ) ( tmrWHEEL_SLOTS - 1U ) )
+        #define tmrWHEEL_LEVELS       ( ( ( sizeof( TickType_t ) * 8U ) + tmrWHEEL_SLOT_BITS - 1U ) / tmrWHEEL_SLOT_BITS )
+
+/* When the timer wheel is used, active timers that expire before the tick
+ * count next overflows are held in xTimerWheel rather than pxCurrentTimerList.
+ * A timer is placed on the lowest level at which its expiry time agrees with
+ * xTimerWheelTime on all of the more significant slot digits, in the slot
+ * selected by its own digit at that level.  Timers that share a slot are kept
+ * in insertion order and the list item value still holds the expiry time.
+ * Slots of the higher levels are cascaded down as xTimerWheelTime reaches
+ * them.  pxOverflowTimerList is not kept sorted in this configuration. */
+        PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+        PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ tmrWHEEL_LEVELS ];
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+    #endif /* configUSE_TIMER_WHEEL */
+
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+    #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+
+/* Timers reset through xTimerResetMultiple() that the timer service task has
+ * not processed yet.  Each timer is on the list at most once, so repeated
+ * resets of the same timer only update its command time and never take space
+ * in the timer queue.  Only accessed from critical sections. */
+        PRIVILEGED_DATA static Timer_t * pxPendingTimers = NULL;
+    #endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -170,6 +212,63 @@
  */
     static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by prvProcessReceivedCommands() to act on one command received on the
+ * timer queue.  xIsSuperseded is pdTRUE if a later command in the same batch
+ * applies to the same timer.
+ */
+    static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage,
+                                   const BaseType_t xIsSuperseded ) PRIVILEGED_FUNCTION;
+
+/*
+ * Start or reset a timer as if the command was issued at xCommandTime,
+ * calling its callback straight away if it has already expired.
+ */
+    static void prvRestartTimer( Timer_t * const pxTimer,
+                                 const TickType_t xCommandTime,
+                                 const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+
+/*
+ * Returns pdTRUE if pxMessages[ uxIndex ] starts or resets a timer that a
+ * later command of the batch also applies to.
+ */
+        static BaseType_t prvIsCommandSuperseded( const DaemonTaskMessage_t * const pxMessages,
+                                                  const UBaseType_t uxIndex,
+                                                  const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record a reset of the timer at xCommandTime on the list of pending resets.
+ * Returns pdTRUE if the list was empty, in which case the timer service task
+ * needs to be woken.  Must be called from a critical section.
+ */
+        static BaseType_t prvAddPendingReset( Timer_t * const pxTimer,
+                                              const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Cancel the pending reset of the timer, if any, returning its command time
+ * in *pxCommandTime.  Must be called from a critical section.
+ */
+        static BaseType_t prvTakePendingReset( Timer_t * const pxTimer,
+                                               TickType_t * const pxCommandTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a timer that is about to be deleted from the list of pending resets.
+ */
+        static void prvUnlinkPendingTimer( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Apply the resets recorded by xTimerResetMultiple().
+ */
+        static void prvProcessPendingResets( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Get the timer service task to run without blocking the caller.
+ */
+        static void prvWakeTimerTask( void ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_TIMER_COMMAND_BATCHING */
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
@@ -222,6 +321,47 @@
     static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove the timer from whichever active timer list or timer wheel slot it is
+ * referenced from.  The timer must be in a list.
+ */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+    #else
+        #define prvRemoveTimerFromActiveList( pxTimer )    ( void ) uxListRemove( &( ( pxTimer )->xTimerListItem ) )
+    #endif
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Add a timer that expires before the next tick count overflow to the wheel
+ * slot that corresponds to its expiry time, relative to xTimerWheelTime.
+ */
+        static void prvTimerWheelInsert( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the wheel time forward to xNewTime, cascading the timers referenced by
+ * any higher level slot that xNewTime has reached down the wheel.
+ */
+        static void prvTimerWheelAdvance( const TickType_t xNewTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the next time at which the wheel needs attention - either the exact
+ * expiry time of the next timer, or the start of the next higher level slot
+ * that has to be cascaded.  Sets *pxWheelWasEmpty to pdTRUE if the wheel does
+ * not reference any timers.
+ */
+        static TickType_t prvTimerWheelNextEvent( BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+/*
+ * Helpers returning the index of the least significant set bit of a slot
+ * occupancy bitmap, and the slot digit of xTime at the given wheel level.
+ */
+        static UBaseType_t prvTimerWheelLowestSlot( uint32_t ulBitmap ) PRIVILEGED_FUNCTION;
+        static UBaseType_t prvTimerWheelDigit( const TickType_t xTime,
+                                               const UBaseType_t uxLevel ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_TIMER_WHEEL */
+
 /*
  * Called after a Timer_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -436,6 +576,14 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+        {
+            pxNewTimer->ucPendingStatus = 0U;
+            pxNewTimer->pxNextPending = NULL;
+            pxNewTimer->xPendingCommandTime = ( TickType_t ) 0U;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_AUTORELOAD;
@@ -471,6 +619,21 @@
 
             if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
             {
+                #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+                    TickType_t xPendingCommandTime = ( TickType_t ) 0U;
+                    BaseType_t xHadPendingReset;
+
+                    /* This command supersedes a reset still pending from
+                     * xTimerResetMultiple(), which must not be applied after it.
+                     * Cancel it first in case the timer service task runs as
+                     * soon as the command is sent. */
+                    taskENTER_CRITICAL();
+                    {
+                        xHadPendingReset = prvTakePendingReset( xTimer, &xPendingCommandTime );
+                    }
+                    taskEXIT_CRITICAL();
+                #endif
+
                 if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
                 {
                     xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
@@ -479,6 +642,31 @@
                 {
                     xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
                 }
+
+                #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+                {
+                    BaseType_t xWakeTimerTask = pdFALSE;
+
+                    /* The command was not sent, so put back the cancelled reset
+                     * unless a newer one has been recorded since. */
+                    if( ( xReturn != pdPASS ) && ( xHadPendingReset != pdFALSE ) )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            if( ( xTimer->ucPendingStatus & tmrPENDING_RESET ) == 0U )
+                            {
+                                xWakeTimerTask = prvAddPendingReset( xTimer, xPendingCommandTime );
+                            }
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+
+                    if( xWakeTimerTask != pdFALSE )
+                    {
+                        prvWakeTimerTask();
+                    }
+                }
+                #endif /* configUSE_TIMER_COMMAND_BATCHING */
             }
 
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
@@ -520,7 +708,38 @@
 
             if( xCommandID >= tmrFIRST_FROM_ISR_COMMAND )
             {
+                #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+                    TickType_t xPendingCommandTime = ( TickType_t ) 0U;
+                    BaseType_t xHadPendingReset;
+                    UBaseType_t uxSavedInterruptStatus;
+
+                    /* As in xTimerGenericCommandFromTask(). */
+                    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                    {
+                        xHadPendingReset = prvTakePendingReset( xTimer, &xPendingCommandTime );
+                    }
+                    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+                #endif
+
                 xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+                #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+                {
+                    if( ( xReturn != pdPASS ) && ( xHadPendingReset != pdFALSE ) )
+                    {
+                        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                        {
+                            if( ( xTimer->ucPendingStatus & tmrPENDING_RESET ) == 0U )
+                            {
+                                /* The queue is full, so the timer service task
+                                 * will see the reset without being woken. */
+                                ( void ) prvAddPendingReset( xTimer, xPendingCommandTime );
+                            }
+                        }
+                        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+                    }
+                }
+                #endif /* configUSE_TIMER_COMMAND_BATCHING */
             }
 
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
@@ -714,30 +933,61 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        /* MISRA Ref 11.5.3 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+        Timer_t * pxTimer;
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            const List_t * pxSlot;
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            /* xNextExpireTime is either the expiry time of a timer in the
+             * lowest level, or the start of a higher level slot.  Reaching it
+             * cascades any such slot, after which there is only a timer to
+             * process if one expires exactly now. */
+            prvTimerWheelAdvance( xNextExpireTime );
+            pxSlot = &( xTimerWheel[ 0 ][ xTimerWheelTime & tmrWHEEL_SLOT_MASK ] );
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
-        {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+            }
+            else
+            {
+                pxTimer = NULL;
+            }
         }
-        else
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
         {
-            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
         }
+        #endif /* if ( configUSE_TIMER_WHEEL == 1 ) */
+
+        if( pxTimer != NULL )
+        {
+            /* Remove the timer from the list of active timers.  A check has already
+             * been performed to ensure the list is not empty. */
+            prvRemoveTimerFromActiveList( pxTimer );
+
+            /* If the timer is an auto-reload timer then calculate the next
+             * expiry time and re-insert the timer in the list of active timers. */
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+            {
+                prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            }
 
-        /* Call the timer callback. */
-        traceTIMER_EXPIRED( pxTimer );
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+            /* Call the timer callback. */
+            traceTIMER_EXPIRED( pxTimer );
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        }
     }
 /*-----------------------------------------------------------*/
 
@@ -848,17 +1098,25 @@
          * this task to unblock when the tick count overflows, at which point the
          * timer lists will be switched and the next expiry time can be
          * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            xNextExpireTime = prvTimerWheelNextEvent( pxListWasEmpty );
         }
-        else
+        #else
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
+        #endif /* if ( configUSE_TIMER_WHEEL == 1 ) */
 
         return xNextExpireTime;
     }
@@ -909,7 +1167,16 @@
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    /* Sorted when it is moved into the wheel on overflow. */
+                    vListInsertEnd( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #else
+                {
+                    vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #endif
             }
         }
         else
@@ -923,7 +1190,15 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    prvTimerWheelInsert( pxTimer );
+                }
+                #else
+                {
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #endif
             }
         }
 
@@ -931,159 +1206,444 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessReceivedCommands( void )
+    static void prvRestartTimer( Timer_t * const pxTimer,
+                                 const TickType_t xCommandTime,
+                                 const TickType_t xTimeNow )
+    {
+        /* Start or restart a timer. */
+        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+
+        if( prvInsertTimerInActiveList( pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandTime ) != pdFALSE )
+        {
+            /* The timer expired before it was added to the active
+             * timer list.  Process it now. */
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+            {
+                prvReloadTimer( pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow );
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            }
+
+            /* Call the timer callback. */
+            traceTIMER_EXPIRED( pxTimer );
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage,
+                                   const BaseType_t xIsSuperseded )
     {
-        DaemonTaskMessage_t xMessage = { 0 };
         Timer_t * pxTimer;
         BaseType_t xTimerListsWereSwitched;
         TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+        #if ( INCLUDE_xTimerPendFunctionCall == 1 )
         {
-            #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+            /* Negative commands are pended function calls rather than timer
+             * commands. */
+            if( pxMessage->xMessageID < ( BaseType_t ) 0 )
             {
-                /* Negative commands are pended function calls rather than timer
-                 * commands. */
-                if( xMessage.xMessageID < ( BaseType_t ) 0 )
-                {
-                    const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
+                const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
 
-                    /* The timer uses the xCallbackParameters member to request a
-                     * callback be executed.  Check the callback is not NULL. */
-                    configASSERT( pxCallback );
+                /* The timer uses the xCallbackParameters member to request a
+                 * callback be executed.  Check the callback is not NULL. */
+                configASSERT( pxCallback );
 
-                    /* Call the function. */
-                    pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+                /* Call the function. */
+                pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* INCLUDE_xTimerPendFunctionCall */
+
+        /* Commands that are positive are timer commands rather than pended
+         * function calls. */
+        if( pxMessage->xMessageID >= ( BaseType_t ) 0 )
+        {
+            /* The messages uses the xTimerParameters member to work on a
+             * software timer. */
+            pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+
+            if( pxTimer != NULL )
+            {
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+                {
+                    /* The timer is in a list, remove it. */
+                    prvRemoveTimerFromActiveList( pxTimer );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
+
+                /* In this case the xTimerListsWereSwitched parameter is not used, but
+                 *  it must be present in the function call.  prvSampleTimeNow() must be
+                 *  called after the message is received from xTimerQueue so there is no
+                 *  possibility of a higher priority task adding a message to the message
+                 *  queue with a time that is ahead of the timer daemon task (because it
+                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
+                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+                switch( pxMessage->xMessageID )
+                {
+                    case tmrCOMMAND_START:
+                    case tmrCOMMAND_START_FROM_ISR:
+                    case tmrCOMMAND_RESET:
+                    case tmrCOMMAND_RESET_FROM_ISR:
+
+                        /* A later command for the same timer is about to remove
+                         * it from the active list again, so there is nothing to
+                         * do unless the timer has already expired, in which case
+                         * its callback must still run. */
+                        if( ( xIsSuperseded == pdFALSE ) ||
+                            ( ( ( TickType_t ) ( xTimeNow - pxMessage->u.xTimerParameters.xMessageValue ) ) >= pxTimer->xTimerPeriodInTicks ) )
+                        {
+                            prvRestartTimer( pxTimer, pxMessage->u.xTimerParameters.xMessageValue, xTimeNow );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        break;
+
+                    case tmrCOMMAND_STOP:
+                    case tmrCOMMAND_STOP_FROM_ISR:
+                        /* The timer has already been removed from the active list. */
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        break;
+
+                    case tmrCOMMAND_CHANGE_PERIOD:
+                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                        pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                        /* The new period does not really have a reference, and can
+                         * be longer or shorter than the old one.  The command time is
+                         * therefore set to the current time, and as the period cannot
+                         * be zero the next expiry time can only be in the future,
+                         * meaning (unlike for the xTimerStart() case above) there is
+                         * no fail case that needs to be handled here. */
+                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                        break;
+
+                    case tmrCOMMAND_DELETE:
+                        #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+                        {
+                            /* The timer may still be linked into the list of
+                             * pending resets, take it out before it is freed. */
+                            prvUnlinkPendingTimer( pxTimer );
+                        }
+                        #endif
+
+                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                        {
+                            /* The timer has already been removed from the active list,
+                             * just free up the memory if the memory was dynamically
+                             * allocated. */
+                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                            {
+                                vPortFree( pxTimer );
+                            }
+                            else
+                            {
+                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                            }
+                        }
+                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                        {
+                            /* If dynamic allocation is not enabled, the memory
+                             * could not have been dynamically allocated. So there is
+                             * no need to free the memory - just mark the timer as
+                             * "not active". */
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
+                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                        break;
+
+                    default:
+                        /* Don't expect to get here. */
+                        break;
+                }
             }
-            #endif /* INCLUDE_xTimerPendFunctionCall */
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessReceivedCommands( void )
+    {
+        #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+        {
+            DaemonTaskMessage_t xMessages[ configTIMER_COMMAND_BATCH_LENGTH ];
+            UBaseType_t uxCount;
+            UBaseType_t uxIndex;
 
-            /* Commands that are positive are timer commands rather than pended
-             * function calls. */
-            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+            do
             {
-                /* The messages uses the xTimerParameters member to work on a
-                 * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
+                /* Take a batch of commands off the queue before processing any of
+                 * them so a start or reset followed by another command for the
+                 * same timer in the same batch can be skipped. */
+                uxCount = xQueueReceiveMultiple( xTimerQueue, xMessages, ( UBaseType_t ) configTIMER_COMMAND_BATCH_LENGTH, tmrNO_DELAY );
 
-                if( pxTimer != NULL )
+                for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+                {
+                    prvProcessCommand( &( xMessages[ uxIndex ] ), prvIsCommandSuperseded( xMessages, uxIndex, uxCount ) );
+                }
+            } while( uxCount == ( UBaseType_t ) configTIMER_COMMAND_BATCH_LENGTH );
+
+            /* The queue is empty, so every command sent before the pending resets
+             * were recorded has been processed.  Apply them now. */
+            prvProcessPendingResets();
+        }
+        #else /* if ( configUSE_TIMER_COMMAND_BATCHING == 1 ) */
+        {
+            DaemonTaskMessage_t xMessage = { 0 };
+
+            while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+            {
+                prvProcessCommand( &xMessage, pdFALSE );
+            }
+        }
+        #endif /* if ( configUSE_TIMER_COMMAND_BATCHING == 1 ) */
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+
+        static BaseType_t prvIsCommandSuperseded( const DaemonTaskMessage_t * const pxMessages,
+                                                  const UBaseType_t uxIndex,
+                                                  const UBaseType_t uxCount )
+        {
+            const Timer_t * const pxTimer = pxMessages[ uxIndex ].u.xTimerParameters.pxTimer;
+            BaseType_t xReturn = pdFALSE;
+            UBaseType_t uxLater;
+
+            switch( pxMessages[ uxIndex ].xMessageID )
+            {
+                case tmrCOMMAND_START:
+                case tmrCOMMAND_START_FROM_ISR:
+                case tmrCOMMAND_RESET:
+                case tmrCOMMAND_RESET_FROM_ISR:
+
+                    /* Every timer command removes the timer from the active
+                     * list before acting on it. */
+                    for( uxLater = uxIndex + 1U; uxLater < uxCount; uxLater++ )
+                    {
+                        if( ( pxMessages[ uxLater ].xMessageID >= ( BaseType_t ) 0 ) &&
+                            ( pxMessages[ uxLater ].u.xTimerParameters.pxTimer == pxTimer ) )
+                        {
+                            xReturn = pdTRUE;
+                            break;
+                        }
+                    }
+
+                    break;
+
+                default:
+                    break;
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvAddPendingReset( Timer_t * const pxTimer,
+                                              const TickType_t xCommandTime )
+        {
+            BaseType_t xListWasEmpty = pdFALSE;
+
+            /* Must be called from a critical section.  A timer already waiting
+             * for a reset just has its command time updated. */
+            pxTimer->xPendingCommandTime = xCommandTime;
+            pxTimer->ucPendingStatus |= ( uint8_t ) tmrPENDING_RESET;
+
+            if( ( pxTimer->ucPendingStatus & tmrPENDING_IS_LINKED ) == 0U )
+            {
+                xListWasEmpty = ( pxPendingTimers == NULL ) ? pdTRUE : pdFALSE;
+                pxTimer->pxNextPending = pxPendingTimers;
+                pxPendingTimers = pxTimer;
+                pxTimer->ucPendingStatus |= ( uint8_t ) tmrPENDING_IS_LINKED;
+            }
+
+            return xListWasEmpty;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvTakePendingReset( Timer_t * const pxTimer,
+                                               TickType_t * const pxCommandTime )
+        {
+            BaseType_t xReturn = pdFALSE;
+
+            /* Must be called from a critical section.  The timer stays linked
+             * until the timer service task next walks the list. */
+            if( ( pxTimer->ucPendingStatus & tmrPENDING_RESET ) != 0U )
+            {
+                pxTimer->ucPendingStatus &= ( uint8_t ) ~tmrPENDING_RESET;
+                *pxCommandTime = pxTimer->xPendingCommandTime;
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvUnlinkPendingTimer( Timer_t * const pxTimer )
+        {
+            Timer_t ** ppxLink;
+
+            /* Only called by the timer service task while it is not walking the
+             * list itself, so a linked timer is on the shared list. */
+            taskENTER_CRITICAL();
+            {
+                if( ( pxTimer->ucPendingStatus & tmrPENDING_IS_LINKED ) != 0U )
+                {
+                    for( ppxLink = &pxPendingTimers; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextPending ) )
+                    {
+                        if( *ppxLink == pxTimer )
+                        {
+                            *ppxLink = pxTimer->pxNextPending;
+                            break;
+                        }
+                    }
+
+                    pxTimer->ucPendingStatus = 0U;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvProcessPendingResets( void )
+        {
+            Timer_t * pxNext;
+            Timer_t * pxTimer;
+            TickType_t xCommandTime = ( TickType_t ) 0U;
+            TickType_t xTimeNow;
+            BaseType_t xTimerListsWereSwitched;
+            BaseType_t xHasReset;
+
+            taskENTER_CRITICAL();
+            {
+                pxNext = pxPendingTimers;
+                pxPendingTimers = NULL;
+            }
+            taskEXIT_CRITICAL();
+
+            while( pxNext != NULL )
+            {
+                /* Timers on the detached list can still have their pending reset
+                 * updated or cancelled until they are unlinked here. */
+                taskENTER_CRITICAL();
+                {
+                    pxTimer = pxNext;
+                    pxNext = pxTimer->pxNextPending;
+                    xHasReset = prvTakePendingReset( pxTimer, &xCommandTime );
+                    pxTimer->pxNextPending = NULL;
+                    pxTimer->ucPendingStatus = 0U;
+                }
+                taskEXIT_CRITICAL();
+
+                if( xHasReset != pdFALSE )
                 {
                     if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
                     {
-                        /* The timer is in a list, remove it. */
-                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                        prvRemoveTimerFromActiveList( pxTimer );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+                    traceTIMER_COMMAND_RECEIVED( pxTimer, tmrCOMMAND_RESET, xCommandTime );
 
-                    /* In this case the xTimerListsWereSwitched parameter is not used, but
-                     *  it must be present in the function call.  prvSampleTimeNow() must be
-                     *  called after the message is received from xTimerQueue so there is no
-                     *  possibility of a higher priority task adding a message to the message
-                     *  queue with a time that is ahead of the timer daemon task (because it
-                     *  pre-empted the timer daemon task after the xTimeNow value was set). */
                     xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+                    prvRestartTimer( pxTimer, xCommandTime, xTimeNow );
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
 
-                    switch( xMessage.xMessageID )
-                    {
-                        case tmrCOMMAND_START:
-                        case tmrCOMMAND_START_FROM_ISR:
-                        case tmrCOMMAND_RESET:
-                        case tmrCOMMAND_RESET_FROM_ISR:
-                            /* Start or restart a timer. */
-                            pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
-
-                            if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                            {
-                                /* The timer expired before it was added to the active
-                                 * timer list.  Process it now. */
-                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
-                                {
-                                    prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                                }
-                                else
-                                {
-                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                                }
-
-                                /* Call the timer callback. */
-                                traceTIMER_EXPIRED( pxTimer );
-                                pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+        static void prvWakeTimerTask( void )
+        {
+            DaemonTaskMessage_t xMessage;
 
-                            break;
+            /* A timer command without a timer is ignored by the timer service
+             * task, but gets it to run.  If the queue is full the timer service
+             * task has commands to process anyway, and it always checks the
+             * pending resets after emptying the queue. */
+            xMessage.xMessageID = tmrCOMMAND_START_DONT_TRACE;
+            xMessage.u.xTimerParameters.xMessageValue = ( TickType_t ) 0U;
+            xMessage.u.xTimerParameters.pxTimer = NULL;
 
-                        case tmrCOMMAND_STOP:
-                        case tmrCOMMAND_STOP_FROM_ISR:
-                            /* The timer has already been removed from the active list. */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            break;
+            ( void ) xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+        }
+/*-----------------------------------------------------------*/
 
-                        case tmrCOMMAND_CHANGE_PERIOD:
-                        case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                            pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
-                            pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                            configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                            /* The new period does not really have a reference, and can
-                             * be longer or shorter than the old one.  The command time is
-                             * therefore set to the current time, and as the period cannot
-                             * be zero the next expiry time can only be in the future,
-                             * meaning (unlike for the xTimerStart() case above) there is
-                             * no fail case that needs to be handled here. */
-                            ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                            break;
+        BaseType_t xTimerResetMultiple( TimerHandle_t const * pxTimers,
+                                        const UBaseType_t uxTimerCount )
+        {
+            BaseType_t xReturn = pdFAIL;
+            BaseType_t xWakeTimerTask = pdFALSE;
+            TickType_t xCommandTime;
+            UBaseType_t uxIndex;
 
-                        case tmrCOMMAND_DELETE:
-                            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                            {
-                                /* The timer has already been removed from the active list,
-                                 * just free up the memory if the memory was dynamically
-                                 * allocated. */
-                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-                                {
-                                    vPortFree( pxTimer );
-                                }
-                                else
-                                {
-                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                                }
-                            }
-                            #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                            {
-                                /* If dynamic allocation is not enabled, the memory
-                                 * could not have been dynamically allocated. So there is
-                                 * no need to free the memory - just mark the timer as
-                                 * "not active". */
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
-                            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                            break;
+            traceENTER_xTimerResetMultiple( pxTimers, uxTimerCount );
 
-                        default:
-                            /* Don't expect to get here. */
-                            break;
+            configASSERT( ( pxTimers != NULL ) || ( uxTimerCount == 0U ) );
+
+            if( xTimerQueue != NULL )
+            {
+                taskENTER_CRITICAL();
+                {
+                    xCommandTime = xTaskGetTickCount();
+
+                    for( uxIndex = 0U; uxIndex < uxTimerCount; uxIndex++ )
+                    {
+                        configASSERT( pxTimers[ uxIndex ] );
+
+                        if( prvAddPendingReset( pxTimers[ uxIndex ], xCommandTime ) != pdFALSE )
+                        {
+                            xWakeTimerTask = pdTRUE;
+                        }
                     }
                 }
-                else
+                taskEXIT_CRITICAL();
+
+                if( xWakeTimerTask != pdFALSE )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    prvWakeTimerTask();
                 }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+
+            traceRETURN_xTimerResetMultiple( xReturn );
+
+            return xReturn;
         }
-    }
+
+    #endif /* configUSE_TIMER_COMMAND_BATCHING */
 /*-----------------------------------------------------------*/
 
     static void prvSwitchTimerLists( void )
@@ -1095,22 +1655,212 @@
          * If there are any timers still referenced from the current timer list
          * then they must have expired and should be processed before the lists
          * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            BaseType_t xWheelWasEmpty;
+
+            ( void ) pxTemp;
+
+            for( ; ; )
+            {
+                xNextExpireTime = prvTimerWheelNextEvent( &xWheelWasEmpty );
+
+                if( xWheelWasEmpty != pdFALSE )
+                {
+                    break;
+                }
+
+                /* As below.  Auto-reload timers are only reinserted into the
+                 * overflow list from here. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            /* The wheel is empty, so restart it at the beginning of the new tick
+             * count epoch and move the overflow timers into it. */
+            xTimerWheelTime = ( TickType_t ) 0U;
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            while( listLIST_IS_EMPTY( pxOverflowTimerList ) == pdFALSE )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxOverflowTimerList );
+
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                prvTimerWheelInsert( pxTimer );
+            }
         }
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
+        {
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            pxTemp = pxCurrentTimerList;
+            pxCurrentTimerList = pxOverflowTimerList;
+            pxOverflowTimerList = pxTemp;
+        }
+        #endif /* if ( configUSE_TIMER_WHEEL == 1 ) */
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static UBaseType_t prvTimerWheelLowestSlot( uint32_t ulBitmap )
+        {
+            /* De Bruijn sequence lookup of the least significant set bit.
+             * ulBitmap must not be zero. */
+            static const uint8_t ucDeBruijnBitPosition[ 32 ] =
+            {
+                0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,  8U,
+                31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U
+            };
+
+            return ( UBaseType_t ) ucDeBruijnBitPosition[ ( uint32_t ) ( ( ulBitmap & ( ~ulBitmap + 1U ) ) * 0x077CB531UL ) >> 27 ];
+        }
+/*-----------------------------------------------------------*/
+
+        static UBaseType_t prvTimerWheelDigit( const TickType_t xTime,
+                                               const UBaseType_t uxLevel )
+        {
+            return ( UBaseType_t ) ( ( xTime >> ( uxLevel * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK );
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvTimerWheelInsert( Timer_t * const pxTimer )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            UBaseType_t uxLevel;
+            UBaseType_t uxSlot;
+
+            configASSERT( xExpiryTime >= xTimerWheelTime );
+
+            /* Find the lowest level above which the expiry time and the wheel
+             * time agree.  The top level covers whatever remains. */
+            for( uxLevel = 0U; uxLevel < ( tmrWHEEL_LEVELS - 1U ); uxLevel++ )
+            {
+                if( ( ( xExpiryTime ^ xTimerWheelTime ) >> ( ( uxLevel + 1U ) * tmrWHEEL_SLOT_BITS ) ) == ( TickType_t ) 0U )
+                {
+                    break;
+                }
+            }
+
+            uxSlot = prvTimerWheelDigit( xExpiryTime, uxLevel );
+            vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+            ulTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer )
+        {
+            List_t * const pxList = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+            size_t uxIndex;
+
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+            /* Keep the occupancy bitmap in step if that emptied a wheel slot. */
+            if( ( pxList >= &( xTimerWheel[ 0 ][ 0 ] ) ) &&
+                ( pxList <= &( xTimerWheel[ tmrWHEEL_LEVELS - 1U ][ tmrWHEEL_SLOTS - 1U ] ) ) &&
+                ( listLIST_IS_EMPTY( pxList ) != pdFALSE ) )
+            {
+                uxIndex = ( size_t ) ( pxList - &( xTimerWheel[ 0 ][ 0 ] ) );
+                ulTimerWheelOccupied[ uxIndex / tmrWHEEL_SLOTS ] &= ~( 1UL << ( uxIndex % tmrWHEEL_SLOTS ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvTimerWheelAdvance( const TickType_t xNewTime )
+        {
+            UBaseType_t uxLevel;
+            UBaseType_t uxSlot;
+            List_t * pxSlot;
+
+            if( xNewTime > xTimerWheelTime )
+            {
+                xTimerWheelTime = xNewTime;
+            }
+
+            /* Every timer is referenced from the level at which its expiry time
+             * first differs from the wheel time.  Timers in a higher level slot
+             * that the wheel time has now reached no longer satisfy that, so move
+             * them down.  Working from the top level ensures timers cascaded into
+             * a slot that has also been reached are moved on again. */
+            for( uxLevel = tmrWHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+            {
+                uxSlot = prvTimerWheelDigit( xTimerWheelTime, uxLevel );
+
+                if( ( ulTimerWheelOccupied[ uxLevel ] & ( 1UL << uxSlot ) ) != 0UL )
+                {
+                    pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
+                    ulTimerWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+
+                    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                    {
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                        prvTimerWheelInsert( pxTimer );
+                    }
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvTimerWheelNextEvent( BaseType_t * const pxWheelWasEmpty )
+        {
+            TickType_t xNextEvent = ( TickType_t ) 0U;
+            TickType_t xHighBits;
+            UBaseType_t uxLevel;
+            UBaseType_t uxShift;
+            uint32_t ulPending;
+
+            *pxWheelWasEmpty = pdTRUE;
+
+            /* Every timer in a level expires after every timer in the levels
+             * below it, and no slot below the wheel time's own digit is in use,
+             * so the first occupied slot at or above that digit on the lowest
+             * non-empty level holds the next timer to expire. */
+            for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+            {
+                ulPending = ulTimerWheelOccupied[ uxLevel ] & ~( ( 1UL << prvTimerWheelDigit( xTimerWheelTime, uxLevel ) ) - 1UL );
+
+                if( ulPending != 0UL )
+                {
+                    uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+
+                    if( uxLevel < ( tmrWHEEL_LEVELS - 1U ) )
+                    {
+                        xHighBits = xTimerWheelTime & ~( ( ( TickType_t ) 1U << ( uxShift + tmrWHEEL_SLOT_BITS ) ) - ( TickType_t ) 1U );
+                    }
+                    else
+                    {
+                        xHighBits = ( TickType_t ) 0U;
+                    }
+
+                    /* For the lowest level this is the exact expiry time.  For
+                     * higher levels it is the start of the slot, at which point
+                     * the slot gets cascaded. */
+                    xNextEvent = xHighBits | ( ( TickType_t ) prvTimerWheelLowestSlot( ulPending ) << uxShift );
+                    *pxWheelWasEmpty = pdFALSE;
+                    break;
+                }
+            }
+
+            return xNextEvent;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
     static void prvCheckForValidListAndQueue( void )
     {
         /* Check that the list from which active timers are referenced, and the
@@ -1125,6 +1875,25 @@
                 pxCurrentTimerList = &xActiveTimerList1;
                 pxOverflowTimerList = &xActiveTimerList2;
 
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel;
+                    UBaseType_t uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+
+                        ulTimerWheelOccupied[ uxLevel ] = 0UL;
+                    }
+
+                    xTimerWheelTime = ( TickType_t ) 0U;
+                }
+                #endif /* configUSE_TIMER_WHEEL */
+
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* The timer queue is allocated statically in case
@@ -1334,6 +2103,20 @@
     {
         xTimerQueue = NULL;
         xTimerTaskHandle = NULL;
+
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* The slots are initialised again with the timer queue, the wheel
+             * time must restart with the tick count. */
+            xTimerWheelTime = ( TickType_t ) 0U;
+        }
+        #endif
+
+        #if ( configUSE_TIMER_COMMAND_BATCHING == 1 )
+        {
+            pxPendingTimers = NULL;
+        }
+        #endif
     }
 /*-----------------------------------------------------------*/
 
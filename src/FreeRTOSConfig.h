@@ -7,33 +7,77 @@
  * -------------------------------------------------------------------- */
 
 #define configUSE_PREEMPTION                    1
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1 /* Iki seviyeli bitmap + clz ile O(1) secim */
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 #define configTICK_RATE_HZ                      ( 1000 ) /* 1 ms tick */
 
+/* Tick thread'i usleep yerine mutlak zamanli timerfd ile calissin (sadece Linux). */
+#define configPOSIX_TICK_USE_TIMERFD            1
+
+/* Kritik bolgelerde pthread_sigmask yerine thread'e ozel bayrak kullan (syscall yok).
+ * Olcum icin derleme satirindan degistirilebilir, bkz. 'make bench LAZY=0'. */
+#ifndef configPOSIX_LAZY_INTERRUPT_MASK
+    #define configPOSIX_LAZY_INTERRUPT_MASK     1
+#endif
+
 /* * ÖNEMLİ: PC'de "printf" ve string işlemleri çok fazla Stack kullanır.
  * Varsayılan 128 değeri SegFault (Çökme) yaratır. 
  * Bunu 1024 yaparak çökmeyi engelliyoruz.
  */
 #define configMINIMAL_STACK_SIZE                ( ( unsigned short ) 1024 )
 
+/* Gorevler kendi pthread yiginlarinda calisir; 8 MiB varsayilan yerine 64 KiB
+ * ayrilir, cok sayida canli gorev icin adres alani ve sayfa tablosu tasarrufu. */
+#define configPOSIX_THREAD_STACK_SIZE           ( 64 * 1024 )
+
 /* * Heap Boyutu: Dinamik görev oluşturma ve 'asprintf' kullanımı için 
  * yeterli alan. 1MB ayırıyoruz.
  */
 #define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 1024 * 1024 ) )
 
+/* Heap istatistikleri: canli/tepe bayt, boyut histogrami ve cagri noktalari.
+ * Cikista stderr'e dokulur, heap ve stack boyutlarini ayarlamak icin. */
+#define configUSE_HEAP_STATS                    1
+#define configHEAP_STATS_CALL_SITES             32
+
 #define configMAX_TASK_NAME_LEN                 ( 20 )
 
 /* * Öncelik Seviyesi:
- * Senin 4 seviyen + Idle Task + Controller Task için en az 10 yapıyoruz.
+ * Senin 4 seviyen + Idle Task + Controller Task için en az 10 gerekir.
+ * Geri besleme ile dusurme icin 256 seviye; secim bitmap ile O(1) kalir.
  */
-#define configMAX_PRIORITIES                    ( 10 )
+#define configMAX_PRIORITIES                    ( 256 )
 
 #define configUSE_TRACE_FACILITY                1
+#define configUSE_TASK_SNAPSHOT                 1   /* Zamanlayiciyi durdurmadan gorev durumu okuma */
+/* Havuzdaki 64 isci (WORKER_POOL_MAX), calisan isciler, Controller, Idle ve
+ * Timer gorevleri icin yer. Sigmayan gorevler uxTaskGetSnapshotMissedTasks()
+ * ile sayilir. */
+#define configTASK_SNAPSHOT_MAX_TASKS           256
+
+/* Gorev basina calisma suresi: port'ta CLOCK_MONOTONIC'ten 64 bit nanosaniye sayaci. */
+#define configGENERATE_RUN_TIME_STATS           1
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+
+/* Gorev basina hazir -> calisiyor gecikme histogrami (uyanma gecikmesi, ns). */
+#define configUSE_SCHEDULING_LATENCY_HISTOGRAM  1
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
+
+/* Gecikmeli gorev listeleri icin uyanma zamanina gore ekleme ipuclari.
+ * Cok sayida gorev uyurken vTaskDelay ekleme maliyetini dusurur. */
+#define configUSE_DELAYED_LIST_INDEX            1
+#define configDELAYED_LIST_INDEX_SLOTS          256U
+#define configDELAYED_LIST_INDEX_SHIFT          0U
+
+/* Kuyruk/semafor bekleme listeleri icin oncelik bitmap'i ve son bekleyen
+ * ipuclari. Ayni nesnede cok sayida gorev beklerken ekleme O(1) olur. */
+#define configUSE_EVENT_LIST_INDEX              1
+#define configEVENT_LIST_INDEX_SLOTS            256U
+
 #define configUSE_MUTEXES                       1
 #define configCHECK_FOR_STACK_OVERFLOW          0 
 #define configUSE_RECURSIVE_MUTEXES             1
@@ -42,6 +86,11 @@
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_ALTERNATIVE_API               0
 #define configUSE_QUEUE_SETS                    1
+#define configUSE_QUEUE_SET_READY_LIST          1   /* Kume her dolu uyeyi bir kez tutar; oge sayisi artinca tasmaz */
+#define configUSE_QUEUE_ZERO_COPY               1   /* Kuyrukta kopyasiz reserve/commit, acquire/release */
+#define configUSE_SPSC_QUEUES                   1   /* Tek ureticili/tek tuketicili kilitsiz kuyruk */
+#define configUSE_LIGHTWEIGHT_SYNC              1   /* Tek bekleyenli hafif semafor/olay, bildirimle uyandirir */
+#define configUSE_EVENT_GROUP_WAITER_INDEX      1   /* Olay grubu bekleyenleri bit bazinda listelenir */
 #define configUSE_TASK_NOTIFICATIONS            1
 
 /* Software Timer Ayarları */
@@ -49,6 +98,14 @@
 #define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH                20
 #define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 2 )
+/* Aktif zamanlayicilar sirali liste yerine hiyerarsik zaman carkinda tutulur,
+ * binlerce zamanlayicida baslat/durdur/sifirla O(1) kalir. */
+#define configUSE_TIMER_WHEEL                   1
+
+/* Zamanlayici komutlari kuyruktan toplu alinir, gereksiz start/reset atlanir.
+ * xTimerResetMultiple() kuyrugu doldurmadan toplu yeniden kurma saglar. */
+#define configUSE_TIMER_COMMAND_BATCHING        1
+#define configTIMER_COMMAND_BATCH_LENGTH        8
 
 /* Dahil Edilecek Opsiyonel Fonksiyonlar */
 #define INCLUDE_vTaskPrioritySet                1
@@ -65,4 +122,13 @@
 extern void vAssertCalled( unsigned long ulLine, const char * const pcFileName );
 #define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __LINE__, __FILE__ )
 
+/* Ikili cekirdek izleyici: trace makrolari thread basina halka tampona yazar.
+ * FREERTOS_TRACE=dosya ile cikista, SIGUSR2 ile istendiginde dokum alinir;
+ * 'make trace2json' ile Chrome/Perfetto JSON'a cevrilir. */
+#define configUSE_TRACE_RECORDER                1
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+    #include "trace_recorder.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
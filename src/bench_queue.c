@@ -0,0 +1,120 @@
+/* src/bench_queue.c */
+// Kuyruk gecikme olcumu: configPOSIX_LAZY_INTERRUPT_MASK'in kritik bolge
+// maliyetine etkisini gosterir. Iki olcum yapilir, her biri 3 kez:
+//  - bekleyen yokken xQueueSend + xQueueReceive cifti (tek gorev)
+//  - iki gorev arasinda kuyruk ping-pong gidis-donusu
+// Ornek: make bench && ./bench_queue_lazy1
+//        make bench LAZY=0 && ./bench_queue_lazy0
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#define BENCH_RUNS 3
+
+static QueueHandle_t xPing, xPong;
+static unsigned long ulPairCount = 1000000UL;
+static unsigned long ulRoundTripCount = 100000UL;
+
+void vAssertCalled( unsigned long ulLine, const char * const pcFileName )
+{
+    printf("ASSERT ERROR! File: %s Line: %ld\n", pcFileName, ulLine);
+    exit(-1);
+}
+
+static unsigned long long NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+static unsigned long long Median(unsigned long long *samples)
+{
+    unsigned long long tmp;
+    int i, j;
+
+    for(i = 1; i < BENCH_RUNS; i++) {
+        for(j = i; j > 0 && samples[j - 1] > samples[j]; j--) {
+            tmp = samples[j];
+            samples[j] = samples[j - 1];
+            samples[j - 1] = tmp;
+        }
+    }
+    return samples[BENCH_RUNS / 2];
+}
+
+// Ping'e gelen her degeri Pong ile geri yollar
+static void vPongTask(void *pvParameters)
+{
+    unsigned long value;
+
+    (void) pvParameters;
+
+    for(;;) {
+        xQueueReceive(xPing, &value, portMAX_DELAY);
+        xQueueSend(xPong, &value, portMAX_DELAY);
+    }
+}
+
+static void vBenchTask(void *pvParameters)
+{
+    unsigned long long pair[BENCH_RUNS], roundTrip[BENCH_RUNS], start;
+    unsigned long i, value = 0;
+    int run;
+
+    (void) pvParameters;
+
+    for(run = 0; run < BENCH_RUNS; run++) {
+        // Kuyruk bos, kimse beklemiyor: sadece kritik bolge ve kopyalama maliyeti
+        start = NowNs();
+        for(i = 0; i < ulPairCount; i++) {
+            xQueueSend(xPing, &i, 0);
+            xQueueReceive(xPing, &value, 0);
+        }
+        pair[run] = (NowNs() - start) / ulPairCount;
+    }
+
+    xTaskCreate(vPongTask, "Pong", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 2, NULL);
+
+    for(run = 0; run < BENCH_RUNS; run++) {
+        // Her tur iki bloklama ve iki gorev degisimi icerir
+        start = NowNs();
+        for(i = 0; i < ulRoundTripCount; i++) {
+            xQueueSend(xPing, &i, portMAX_DELAY);
+            xQueueReceive(xPong, &value, portMAX_DELAY);
+        }
+        roundTrip[run] = (NowNs() - start) / ulRoundTripCount;
+    }
+
+    printf("[Bench] configPOSIX_LAZY_INTERRUPT_MASK=%d, %d olcumun medyani\n",
+           configPOSIX_LAZY_INTERRUPT_MASK, BENCH_RUNS);
+    printf("[Bench] xQueueSend + xQueueReceive cifti (%lu kez): %llu ns\n",
+           ulPairCount, Median(pair));
+    printf("[Bench] kuyruk ping-pong gidis-donus (%lu kez): %llu ns\n",
+           ulRoundTripCount, Median(roundTrip));
+
+    exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+    // Istege bagli tekrar sayilari: ./bench_queue_lazy1 [cift] [gidis-donus]
+    if(argc > 1) ulPairCount = strtoul(argv[1], NULL, 10);
+    if(argc > 2) ulRoundTripCount = strtoul(argv[2], NULL, 10);
+    if(ulPairCount == 0 || ulRoundTripCount == 0) {
+        fprintf(stderr, "kullanim: %s [cift sayisi] [gidis-donus sayisi]\n", argv[0]);
+        return 1;
+    }
+
+    xPing = xQueueCreate(1, sizeof(unsigned long));
+    xPong = xQueueCreate(1, sizeof(unsigned long));
+
+    xTaskCreate(vBenchTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+    vTaskStartScheduler();
+
+    return 0;
+}
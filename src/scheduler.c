@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <dlfcn.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "scheduler.h"
@@ -31,6 +32,243 @@ void PrintTaskInfo(SimTask* task, char* statusMsg)
     fflush(stdout);
 }
 
+// --- ISCI HAVUZU ---
+// Bosta bekleyen (askida) isci gorevleri. Yigin olarak kullanilir.
+static TaskHandle_t workerPool[WORKER_POOL_MAX];
+static int workerPoolCount = 0;
+
+// Yeni bir isci olusturur, askiya alir ve dondurur (hata durumunda NULL)
+static TaskHandle_t CreateWorker(void)
+{
+    TaskHandle_t handle = NULL;
+
+    xTaskCreate(vGenericTask, "Generic", configMINIMAL_STACK_SIZE,
+                NULL, tskIDLE_PRIORITY + 1, &handle);
+
+    if(handle != NULL) vTaskSuspend(handle);
+
+    return handle;
+}
+
+// Havuzdan bir isci alir, havuz bossa yenisini olusturur
+static TaskHandle_t AcquireWorker(void)
+{
+    if(workerPoolCount > 0) {
+        return workerPool[--workerPoolCount];
+    }
+    return CreateWorker();
+}
+
+// Isciyi havuza geri verir. Isci askida olmali. Havuz doluysa silinir.
+static void ReleaseWorker(TaskHandle_t handle)
+{
+    if(handle == NULL) return;
+
+    if(workerPoolCount < WORKER_POOL_MAX) {
+        workerPool[workerPoolCount++] = handle;
+    } else {
+        vTaskDelete(handle);
+    }
+}
+
+// Tick gecikme istatistikleri (stderr'e, simulasyon ciktisini bozmamak icin)
+void PrintTickStats(void)
+{
+    PortTickStats_t stats;
+    vPortGetTickStats(&stats);
+
+    if(stats.ullTicksHandled == 0) return;
+
+    fprintf(stderr, "[Tick] %llu tick, gecikme min/ort/max: %llu/%llu/%llu ns, jitter ort/max: %llu/%llu ns, birlestirilen: %llu\n",
+            (unsigned long long)stats.ullTicksHandled,
+            (unsigned long long)stats.ullLatencyMinNs,
+            (unsigned long long)(stats.ullLatencyTotalNs / stats.ullTicksHandled),
+            (unsigned long long)stats.ullLatencyMaxNs,
+            (unsigned long long)(stats.ullTicksHandled > 1 ? stats.ullJitterTotalNs / (stats.ullTicksHandled - 1) : 0),
+            (unsigned long long)stats.ullJitterMaxNs,
+            (unsigned long long)stats.ullTicksCoalesced);
+    fprintf(stderr, "[Tick] gecen/islenen: %llu/%llu, gec islenen: %llu (tek seferde en fazla %llu), en buyuk kayma: %llu ns\n",
+            (unsigned long long)stats.ullTicksElapsed,
+            (unsigned long long)stats.ullTicksProcessed,
+            (unsigned long long)stats.ullTicksCaughtUp,
+            (unsigned long long)stats.ullMaxTicksPerHandler,
+            (unsigned long long)stats.ullDriftMaxNs);
+}
+
+// Heap istatistikleri (configUSE_HEAP_STATS)
+void PrintHeapStats(void)
+{
+#if ( configUSE_HEAP_STATS == 1 )
+    HeapStats_t stats;
+    HeapCallSiteStats_t sites[8];
+    UBaseType_t count, i;
+
+    vPortGetHeapStats(&stats);
+
+    fprintf(stderr, "[Heap] canli: %zu bayt, tepe: %zu bayt, en az bos: %zu bayt, ayirma/serbest: %zu/%zu\n",
+            stats.xCurrentAllocatedBytes,
+            stats.xPeakAllocatedBytes,
+            stats.xMinimumEverFreeBytesRemaining,
+            stats.xNumberOfSuccessfulAllocations,
+            stats.xNumberOfSuccessfulFrees);
+
+    fprintf(stderr, "[Heap] boyut histogrami:");
+    for(i = 0; i < portHEAP_STATS_HISTOGRAM_BUCKETS; i++) {
+        if(stats.xAllocationSizeHistogram[i] != 0) {
+            fprintf(stderr, " %lu+:%zu", 1UL << i, stats.xAllocationSizeHistogram[i]);
+        }
+    }
+    fprintf(stderr, "\n");
+
+    // Ofsetler "addr2line -e freertos_sim <ofset>" ile kaynak satirina cevrilebilir
+    count = uxPortGetHeapCallSiteStats(sites, 8);
+    for(i = 0; i < count; i++) {
+        Dl_info info;
+        unsigned long offset = (unsigned long)sites[i].pvCallSite;
+
+        if(sites[i].pvCallSite != NULL && dladdr(sites[i].pvCallSite, &info) != 0) {
+            offset -= (unsigned long)info.dli_fbase;
+        }
+
+        fprintf(stderr, "[Heap] 0x%lx: %zu ayirma, %zu serbest, canli %zu bayt, toplam %zu bayt\n",
+                offset,
+                sites[i].xNumberOfAllocations,
+                sites[i].xNumberOfFrees,
+                sites[i].xCurrentBytes,
+                sites[i].xTotalBytes);
+    }
+#endif
+}
+
+// Gorev basina calisma suresi (configGENERATE_RUN_TIME_STATS, stderr'e)
+void PrintRunTimeStats(void)
+{
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+    static char buffer[4096];
+
+    vTaskGetRunTimeStatistics(buffer, sizeof(buffer));
+
+    fprintf(stderr, "[RunTime] %.3f sn sonunda (gorev, ns, yuzde):\n%s",
+            (double)portGET_RUN_TIME_COUNTER_VALUE() / 1e9,
+            buffer);
+#endif
+}
+
+// Gorev basina uyanma gecikmesi (configUSE_SCHEDULING_LATENCY_HISTOGRAM, stderr'e)
+void PrintSchedulingLatency(void)
+{
+#if ( configUSE_SCHEDULING_LATENCY_HISTOGRAM == 1 ) && ( configUSE_TASK_SNAPSHOT == 1 )
+    static TaskLatencyHistogram_t hist, all;
+    TaskStatus_t *status;
+    UBaseType_t count, i, b;
+
+    count = uxTaskGetNumberOfTasks() + 4;
+    status = malloc(count * sizeof(TaskStatus_t));
+    if(status == NULL) return;
+
+    // Tutamaclar ve gorev adlari TCB'yi gosterir, silinen bir gorevin TCB'si
+    // bosaltilmasin diye zamanlayici okuma bitene kadar askiya alinir
+    vTaskSuspendAll();
+    count = uxTaskGetSystemSnapshot(status, count, NULL);
+    memset(&all, 0, sizeof(all));
+
+    if(uxTaskGetSnapshotMissedTasks() != 0) {
+        fprintf(stderr, "[Latency] %lu gorev kayit defterine sigmadi, configTASK_SNAPSHOT_MAX_TASKS arttirilmali\n",
+                (unsigned long)uxTaskGetSnapshotMissedTasks());
+    }
+
+    fprintf(stderr, "[Latency] gorev, ornek, min/p50/p90/p99/max ns, ortalama ns:\n");
+    for(i = 0; i < count; i++) {
+        vTaskGetSchedulingLatency(status[i].xHandle, &hist);
+        if(hist.ulSamples == 0) continue;
+
+        fprintf(stderr, "[Latency] %-12s %6llu  %llu/%llu/%llu/%llu/%llu  %llu\n",
+                status[i].pcTaskName,
+                (unsigned long long)hist.ulSamples,
+                (unsigned long long)hist.ulMin,
+                (unsigned long long)ulTaskGetSchedulingLatencyPercentile(&hist, 50),
+                (unsigned long long)ulTaskGetSchedulingLatencyPercentile(&hist, 90),
+                (unsigned long long)ulTaskGetSchedulingLatencyPercentile(&hist, 99),
+                (unsigned long long)hist.ulMax,
+                (unsigned long long)(hist.ulTotal / hist.ulSamples));
+
+        // Tum gorevlerin toplam histogrami
+        if(all.ulSamples == 0 || hist.ulMin < all.ulMin) all.ulMin = hist.ulMin;
+        if(hist.ulMax > all.ulMax) all.ulMax = hist.ulMax;
+        all.ulSamples += hist.ulSamples;
+        all.ulTotal += hist.ulTotal;
+        for(b = 0; b < tskSCHEDULING_LATENCY_BUCKETS; b++) {
+            all.ulBuckets[b] += hist.ulBuckets[b];
+        }
+    }
+    xTaskResumeAll();
+
+    if(all.ulSamples != 0) {
+        fprintf(stderr, "[Latency] %-12s %6llu  %llu/%llu/%llu/%llu/%llu  %llu\n",
+                "(toplam)",
+                (unsigned long long)all.ulSamples,
+                (unsigned long long)all.ulMin,
+                (unsigned long long)ulTaskGetSchedulingLatencyPercentile(&all, 50),
+                (unsigned long long)ulTaskGetSchedulingLatencyPercentile(&all, 90),
+                (unsigned long long)ulTaskGetSchedulingLatencyPercentile(&all, 99),
+                (unsigned long long)all.ulMax,
+                (unsigned long long)(all.ulTotal / all.ulSamples));
+    }
+
+    free(status);
+#endif
+}
+
+// Gorev basina bellek maliyeti (POSIX port, Linux)
+void PrintTaskFootprint(void)
+{
+#if defined( __linux__ ) && ( configUSE_TASK_SNAPSHOT == 1 )
+    PortTaskFootprint_t fp;
+    TaskStatus_t *status;
+    UBaseType_t count, i;
+    size_t fixed, used = 0, reserved = 0;
+
+    count = uxTaskGetNumberOfTasks() + 4;
+    status = malloc(count * sizeof(TaskStatus_t));
+    if(status == NULL) return;
+
+    // Tutamaclar ve gorev adlari TCB'yi gosterir, silinen bir gorevin TCB'si
+    // bosaltilmasin diye zamanlayici okuma bitene kadar askiya alinir
+    vTaskSuspendAll();
+    count = uxTaskGetSystemSnapshot(status, count, NULL);
+
+    if(uxTaskGetSnapshotMissedTasks() != 0) {
+        fprintf(stderr, "[Bellek] %lu gorev kayit defterine sigmadi, configTASK_SNAPSHOT_MAX_TASKS arttirilmali\n",
+                (unsigned long)uxTaskGetSnapshotMissedTasks());
+    }
+
+    fprintf(stderr, "[Bellek] gorev, pthread yigini kullanilan/ayrilan KiB:\n");
+    for(i = 0; i < count; i++) {
+        vPortGetTaskFootprint(status[i].xHandle, &fp);
+        used += fp.uxThreadStackUsedBytes;
+        reserved += fp.uxThreadStackBytes;
+        fprintf(stderr, "[Bellek] %-12s %zu/%zu\n",
+                status[i].pcTaskName,
+                fp.uxThreadStackUsedBytes / 1024,
+                fp.uxThreadStackBytes / 1024);
+    }
+    xTaskResumeAll();
+
+    // TCB, cekirdek yigini ve olay her gorevde aynidir
+    if(count != 0) {
+        fixed = fp.uxTCBBytes + fp.uxKernelStackBytes + fp.uxEventBytes;
+        fprintf(stderr, "[Bellek] gorev basina sabit %zu bayt (TCB %zu, cekirdek yigini %zu, olay %zu), "
+                        "%lu gorev icin toplam ~%zu KiB kullanilan, %zu KiB ayrilan\n",
+                fixed, fp.uxTCBBytes, fp.uxKernelStackBytes, fp.uxEventBytes,
+                (unsigned long)count,
+                (fixed * count + used) / 1024,
+                reserved / 1024);
+    }
+
+    free(status);
+#endif
+}
+
 // Listeye eleman ekleme
 void AddTaskToLinkedList(SimTask *newTask) {
     if (taskListHead == NULL) {
@@ -100,9 +338,15 @@ void vSchedulerController(void *pvParameters)
     
     char *msg = NULL; 
     static int lastScheduledTaskId = -1;
+    int lastRunTimeStatsTime = 0;
 
     for(;;)
     {
+        if(globalTime - lastRunTimeStatsTime >= RUNTIME_STATS_PERIOD) {
+            PrintRunTimeStats();
+            lastRunTimeStatsTime = globalTime;
+        }
+
         // --- 1. ZAMANAŞIMI KONTROLÜ ---
         SimTask *iterator = taskListHead;
         int activeTasks = 0;
@@ -123,7 +367,9 @@ void vSchedulerController(void *pvParameters)
                     PrintTaskInfo(iterator, msg);
                     free(msg); 
                     
-                    if(iterator->handle != NULL) vTaskDelete(iterator->handle);
+                    // Gorev her calismadan sonra askiya alindigi icin isci dogrudan havuza doner
+                    ReleaseWorker(iterator->handle);
+                    iterator->handle = NULL;
                     iterator->state = STATE_TERMINATED;
                 }
             }
@@ -133,6 +379,11 @@ void vSchedulerController(void *pvParameters)
         // ÇIKIŞ KONTROLÜ
         if(activeTasks == 0) {
             printf("\n--- Tum gorevler tamamlandi ---\n");
+            PrintTickStats();
+            PrintHeapStats();
+            PrintRunTimeStats();
+            PrintSchedulingLatency();
+            PrintTaskFootprint();
             SimTask *current = taskListHead;
             while(current != NULL) {
                 SimTask *next = current->next;
@@ -146,10 +397,8 @@ void vSchedulerController(void *pvParameters)
         iterator = taskListHead;
         while(iterator != NULL) {
             if(iterator->state == STATE_WAITING && iterator->arrivalTime <= globalTime) {
-                xTaskCreate(vGenericTask, "Generic", configMINIMAL_STACK_SIZE, 
-                            NULL, tskIDLE_PRIORITY + 1, &iterator->handle);
-                
-                if(iterator->handle != NULL) vTaskSuspend(iterator->handle);
+                // Havuzdan gelen isci zaten askida
+                iterator->handle = AcquireWorker();
                 
                 iterator->state = STATE_READY;
                 // Yeni gelen görevin queueEntryTime'ı zaten arrivalTime olarak ayarlı
@@ -241,10 +490,8 @@ void vSchedulerController(void *pvParameters)
                 PrintTaskInfo(selectedTask, msg);
                 free(msg);
                 
-                if(selectedTask->handle != NULL) {
-                    vTaskDelete(selectedTask->handle);
-                    selectedTask->handle = NULL;
-                }
+                ReleaseWorker(selectedTask->handle);
+                selectedTask->handle = NULL;
                 selectedTask->state = STATE_TERMINATED;
                 lastScheduledTaskId = -1; 
             } 
@@ -277,6 +524,13 @@ void vSchedulerController(void *pvParameters)
 void Scheduler_Init(void) { }
 
 void Scheduler_Start(void) {
+    // Isci havuzunu zamanlayici baslamadan doldur
+    while(workerPoolCount < WORKER_POOL_INITIAL) {
+        TaskHandle_t handle = CreateWorker();
+        if(handle == NULL) break;
+        workerPool[workerPoolCount++] = handle;
+    }
+
     xTaskCreate(vSchedulerController, "Controller", configMINIMAL_STACK_SIZE * 4, NULL, configMAX_PRIORITIES - 1, NULL);
     vTaskStartScheduler();
 }
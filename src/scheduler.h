@@ -15,6 +15,14 @@
 #define ANSI_CYAN    "\x1b[36m"
 #define ANSI_WHITE   "\x1b[37m"
 
+// Isci havuzu: her SimTask icin xTaskCreate/vTaskDelete yerine
+// onceden olusturulmus FreeRTOS gorevleri yeniden kullanilir.
+#define WORKER_POOL_INITIAL  8   // Baslangicta olusturulan isci sayisi
+#define WORKER_POOL_MAX      64  // Havuzda bekletilecek en fazla isci
+
+// Calisma suresi istatistiklerinin kac simulasyon saniyesinde bir basilacagi
+#define RUNTIME_STATS_PERIOD 10
+
 typedef enum {
     STATE_WAITING,
     STATE_READY,
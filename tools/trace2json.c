@@ -0,0 +1,550 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Converts a file written by the POSIX port trace recorder (see
+ * trace_recorder.h) to the Chrome trace event JSON format, which
+ * chrome://tracing and https://ui.perfetto.dev both load.
+ *
+ *     trace2json freertos_trace.bin > trace.json
+ *
+ * Each task gets its own track with one slice per period it was running.
+ * A slice's arguments give how long the task waited between being made ready
+ * and being switched in, and which task made it ready; flow arrows link the
+ * two so blocking chains can be followed across tracks.  Kernel object events
+ * are instant events on the track of the task that was running.  A per-task
+ * summary of the ready-to-running latency is printed to stderr.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace_recorder.h"
+
+typedef struct xEVENT
+{
+    TraceRecord_t xRecord;
+    uint64_t ullSequence; /* Keeps the sort stable for equal timestamps. */
+} Event_t;
+
+typedef struct xTASK_STATE
+{
+    uint64_t ullObject;
+    const TraceObjectName_t * pxName; /* Name in effect when first seen. */
+    uint32_t ulTrackId;
+    uint64_t ullReadyTime;            /* 0 when not waiting to run. */
+    uint64_t ullWokenBy;              /* Task that made it ready, 0 for an ISR. */
+    uint32_t ulFlowId;                /* Pending wake up arrow, 0 for none. */
+    uint64_t ullSwitchedInTime;
+    uint64_t ullLatencyTicks;         /* Latency of the current slice. */
+    uint64_t ullSlices;
+    uint64_t ullLatencySamples;
+    uint64_t ullLatencyTotalTicks;
+    uint64_t ullLatencyMaxTicks;
+} TaskState_t;
+
+static const char * const pcEventNames[ eTraceEventCount ] =
+{
+    [ eTraceEventTaskSwitchedIn ] = "switched in",
+    [ eTraceEventTaskSwitchedOut ] = "switched out",
+    [ eTraceEventTaskReady ] = "ready",
+    [ eTraceEventTaskCreate ] = "task create",
+    [ eTraceEventTaskDelete ] = "task delete",
+    [ eTraceEventTaskDelay ] = "delay",
+    [ eTraceEventTaskDelayUntil ] = "delay until",
+    [ eTraceEventTaskSuspend ] = "suspend",
+    [ eTraceEventTaskResume ] = "resume",
+    [ eTraceEventTaskPrioritySet ] = "priority set",
+    [ eTraceEventPriorityInherit ] = "priority inherit",
+    [ eTraceEventPriorityDisinherit ] = "priority disinherit",
+    [ eTraceEventTick ] = "tick",
+    [ eTraceEventQueueSend ] = "queue send",
+    [ eTraceEventQueueSendFailed ] = "queue send failed",
+    [ eTraceEventQueueReceive ] = "queue receive",
+    [ eTraceEventQueueReceiveFailed ] = "queue receive failed",
+    [ eTraceEventQueueBlockSend ] = "block on queue send",
+    [ eTraceEventQueueBlockReceive ] = "block on queue receive",
+    [ eTraceEventQueueSendFromISR ] = "queue send from ISR",
+    [ eTraceEventQueueReceiveFromISR ] = "queue receive from ISR",
+    [ eTraceEventNotify ] = "notify",
+    [ eTraceEventNotifyFromISR ] = "notify from ISR",
+    [ eTraceEventNotifyBlock ] = "block on notification",
+    [ eTraceEventEventGroupSetBits ] = "event group set bits",
+    [ eTraceEventEventGroupBlock ] = "block on event group",
+    [ eTraceEventStreamSend ] = "stream buffer send",
+    [ eTraceEventStreamReceive ] = "stream buffer receive",
+    [ eTraceEventStreamBlockSend ] = "block on stream buffer send",
+    [ eTraceEventStreamBlockReceive ] = "block on stream buffer receive",
+    [ eTraceEventSpscSend ] = "spsc send",
+    [ eTraceEventSpscReceive ] = "spsc receive",
+    [ eTraceEventSpscBlockSend ] = "block on spsc send",
+    [ eTraceEventSpscBlockReceive ] = "block on spsc receive",
+    [ eTraceEventTimerExpired ] = "timer expired"
+};
+
+static TraceObjectName_t * pxNames = NULL;
+static uint32_t ulNameCount = 0;
+
+static TaskState_t * pxTasks = NULL;
+static uint32_t ulTaskCount = 0;
+static uint32_t ulTaskCapacity = 0;
+
+static uint64_t ullStartTime = 0;
+static double dNsPerTick = 1.0;
+static int iFirstEvent = 1;
+/*-----------------------------------------------------------*/
+
+static void prvDie( const char * pcMessage )
+{
+    fprintf( stderr, "trace2json: %s\n", pcMessage );
+    exit( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRead( void * pvBuffer,
+                     size_t xLength,
+                     FILE * pxFile )
+{
+    if( ( xLength > 0U ) && ( fread( pvBuffer, xLength, 1, pxFile ) != 1U ) )
+    {
+        prvDie( "truncated trace file" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareEvents( const void * pvA,
+                             const void * pvB )
+{
+    const Event_t * pxA = ( const Event_t * ) pvA;
+    const Event_t * pxB = ( const Event_t * ) pvB;
+
+    if( pxA->xRecord.ullTimestamp != pxB->xRecord.ullTimestamp )
+    {
+        return ( pxA->xRecord.ullTimestamp < pxB->xRecord.ullTimestamp ) ? -1 : 1;
+    }
+
+    return ( pxA->ullSequence < pxB->ullSequence ) ? -1 : ( pxA->ullSequence > pxB->ullSequence );
+}
+/*-----------------------------------------------------------*/
+
+/* The name given to an object most recently before ullTime, or the first one
+ * given to it if the event predates them all. */
+static const TraceObjectName_t * prvFindName( uint64_t ullObject,
+                                              uint64_t ullTime )
+{
+    const TraceObjectName_t * pxFound = NULL;
+    uint32_t ulIndex;
+
+    for( ulIndex = 0; ulIndex < ulNameCount; ulIndex++ )
+    {
+        if( pxNames[ ulIndex ].ullObject == ullObject )
+        {
+            if( ( pxFound == NULL ) || ( pxNames[ ulIndex ].ullTimestamp <= ullTime ) )
+            {
+                pxFound = &pxNames[ ulIndex ];
+            }
+        }
+    }
+
+    return pxFound;
+}
+/*-----------------------------------------------------------*/
+
+/* Tasks are keyed on their TCB address and name, so a TCB reused by a new
+ * task starts a new track. */
+static TaskState_t * prvGetTask( uint64_t ullObject,
+                                 uint64_t ullTime )
+{
+    const TraceObjectName_t * pxName = prvFindName( ullObject, ullTime );
+    TaskState_t * pxTask;
+    uint32_t ulIndex;
+
+    for( ulIndex = 0; ulIndex < ulTaskCount; ulIndex++ )
+    {
+        if( ( pxTasks[ ulIndex ].ullObject == ullObject ) && ( pxTasks[ ulIndex ].pxName == pxName ) )
+        {
+            return &pxTasks[ ulIndex ];
+        }
+    }
+
+    if( ulTaskCount == ulTaskCapacity )
+    {
+        ulTaskCapacity = ( ulTaskCapacity == 0U ) ? 64U : ( ulTaskCapacity * 2U );
+        pxTasks = realloc( pxTasks, ulTaskCapacity * sizeof( TaskState_t ) );
+
+        if( pxTasks == NULL )
+        {
+            prvDie( "out of memory" );
+        }
+    }
+
+    pxTask = &pxTasks[ ulTaskCount ];
+    memset( pxTask, 0, sizeof( TaskState_t ) );
+    pxTask->ullObject = ullObject;
+    pxTask->pxName = pxName;
+
+    /* Track 0 is the kernel track. */
+    pxTask->ulTrackId = ++ulTaskCount;
+
+    return pxTask;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintName( const TraceObjectName_t * pxName )
+{
+    size_t xIndex;
+    unsigned char ucChar;
+
+    /* Names come from the traced application, so escape anything that is not
+     * allowed in a JSON string.  Bytes outside ASCII are written as \u00XX
+     * as they are not known to be UTF-8. */
+    for( xIndex = 0; ( xIndex < traceRECORDER_NAME_LENGTH ) && ( pxName->cName[ xIndex ] != '\0' ); xIndex++ )
+    {
+        ucChar = ( unsigned char ) pxName->cName[ xIndex ];
+
+        if( ( ucChar == '"' ) || ( ucChar == '\\' ) )
+        {
+            printf( "\\%c", ucChar );
+        }
+        else if( ( ucChar < 0x20U ) || ( ucChar >= 0x7FU ) )
+        {
+            printf( "\\u%04x", ( unsigned int ) ucChar );
+        }
+        else
+        {
+            putchar( ucChar );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintTaskName( const TaskState_t * pxTask )
+{
+    if( pxTask->pxName != NULL )
+    {
+        prvPrintName( pxTask->pxName );
+    }
+    else
+    {
+        printf( "TCB 0x%" PRIx64, pxTask->ullObject );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBeginEvent( const char * pcPhase,
+                           uint64_t ullTime,
+                           uint32_t ulTrackId )
+{
+    printf( "%s\n{\"ph\":\"%s\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%.3f",
+            iFirstEvent ? "" : ",", pcPhase, ulTrackId,
+            ( double ) ( ullTime - ullStartTime ) * dNsPerTick / 1000.0 );
+    iFirstEvent = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEmitSlice( TaskState_t * pxTask,
+                          uint64_t ullEndTime )
+{
+    const TaskState_t * pxWaker = NULL;
+    uint32_t ulIndex;
+
+    for( ulIndex = 0; ( pxTask->ullWokenBy != 0U ) && ( ulIndex < ulTaskCount ); ulIndex++ )
+    {
+        if( pxTasks[ ulIndex ].ullObject == pxTask->ullWokenBy )
+        {
+            pxWaker = &pxTasks[ ulIndex ];
+        }
+    }
+
+    prvBeginEvent( "X", pxTask->ullSwitchedInTime, pxTask->ulTrackId );
+    printf( ",\"dur\":%.3f,\"name\":\"", ( double ) ( ullEndTime - pxTask->ullSwitchedInTime ) * dNsPerTick / 1000.0 );
+    prvPrintTaskName( pxTask );
+    printf( "\",\"args\":{\"ready_latency_us\":%.3f,\"woken_by\":\"", ( double ) pxTask->ullLatencyTicks * dNsPerTick / 1000.0 );
+
+    if( pxWaker != NULL )
+    {
+        prvPrintTaskName( pxWaker );
+    }
+    else
+    {
+        printf( "ISR/kernel" );
+    }
+
+    printf( "\"}}" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEmitInstant( const Event_t * pxEvent,
+                            uint32_t ulTrackId )
+{
+    const TraceRecord_t * pxRecord = &pxEvent->xRecord;
+    const TraceObjectName_t * pxName = prvFindName( pxRecord->ullObject, pxRecord->ullTimestamp );
+
+    prvBeginEvent( "i", pxRecord->ullTimestamp, ulTrackId );
+    printf( ",\"s\":\"t\",\"name\":\"%s\",\"args\":{\"object\":\"", pcEventNames[ pxRecord->ulEvent ] );
+
+    if( pxName != NULL )
+    {
+        prvPrintName( pxName );
+    }
+    else
+    {
+        printf( "0x%" PRIx64, pxRecord->ullObject );
+    }
+
+    printf( "\",\"value\":%" PRIu64 "}}", pxRecord->ullValue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConvert( const Event_t * pxEvents,
+                        size_t xEventCount )
+{
+    TaskState_t * pxCurrent = NULL;
+    TaskState_t * pxTask;
+    const TraceRecord_t * pxRecord;
+    uint32_t ulNextFlowId = 1;
+    uint32_t ulCurrentIndex = 0;
+    size_t xIndex;
+
+    ullStartTime = ( xEventCount > 0U ) ? pxEvents[ 0 ].xRecord.ullTimestamp : 0U;
+
+    printf( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" );
+
+    for( xIndex = 0; xIndex < xEventCount; xIndex++ )
+    {
+        pxRecord = &pxEvents[ xIndex ].xRecord;
+
+        if( ( pxRecord->ulEvent == eTraceEventNone ) || ( pxRecord->ulEvent >= eTraceEventCount ) )
+        {
+            continue;
+        }
+
+        /* Re-resolve the running task after the task list may have moved. */
+        pxCurrent = ( pxCurrent != NULL ) ? &pxTasks[ ulCurrentIndex ] : NULL;
+
+        switch( pxRecord->ulEvent )
+        {
+            case eTraceEventTaskSwitchedIn:
+                pxTask = prvGetTask( pxRecord->ullObject, pxRecord->ullTimestamp );
+                pxTask->ullSwitchedInTime = pxRecord->ullTimestamp;
+                pxTask->ullLatencyTicks = 0;
+                pxTask->ullSlices++;
+
+                if( pxTask->ullReadyTime != 0U )
+                {
+                    pxTask->ullLatencyTicks = pxRecord->ullTimestamp - pxTask->ullReadyTime;
+                    pxTask->ullLatencySamples++;
+                    pxTask->ullLatencyTotalTicks += pxTask->ullLatencyTicks;
+
+                    if( pxTask->ullLatencyTicks > pxTask->ullLatencyMaxTicks )
+                    {
+                        pxTask->ullLatencyMaxTicks = pxTask->ullLatencyTicks;
+                    }
+
+                    pxTask->ullReadyTime = 0;
+                }
+
+                if( pxTask->ulFlowId != 0U )
+                {
+                    prvBeginEvent( "f", pxRecord->ullTimestamp, pxTask->ulTrackId );
+                    printf( ",\"bp\":\"e\",\"cat\":\"wakeup\",\"name\":\"wakeup\",\"id\":%" PRIu32 "}", pxTask->ulFlowId );
+                    pxTask->ulFlowId = 0;
+                }
+
+                pxCurrent = pxTask;
+                ulCurrentIndex = ( uint32_t ) ( pxTask - pxTasks );
+                break;
+
+            case eTraceEventTaskSwitchedOut:
+
+                if( ( pxCurrent != NULL ) && ( pxCurrent->ullObject == pxRecord->ullObject ) )
+                {
+                    prvEmitSlice( pxCurrent, pxRecord->ullTimestamp );
+                    pxCurrent->ullWokenBy = 0;
+                }
+
+                pxCurrent = NULL;
+                break;
+
+            case eTraceEventTaskReady:
+                pxTask = prvGetTask( pxRecord->ullObject, pxRecord->ullTimestamp );
+                pxCurrent = ( pxCurrent != NULL ) ? &pxTasks[ ulCurrentIndex ] : NULL;
+
+                if( ( pxTask != pxCurrent ) && ( pxTask->ullReadyTime == 0U ) )
+                {
+                    pxTask->ullReadyTime = pxRecord->ullTimestamp;
+                    pxTask->ullWokenBy = ( pxCurrent != NULL ) ? pxCurrent->ullObject : 0U;
+
+                    if( pxCurrent != NULL )
+                    {
+                        pxTask->ulFlowId = ulNextFlowId++;
+                        prvBeginEvent( "s", pxRecord->ullTimestamp, pxCurrent->ulTrackId );
+                        printf( ",\"cat\":\"wakeup\",\"name\":\"wakeup\",\"id\":%" PRIu32 "}", pxTask->ulFlowId );
+                    }
+                }
+
+                break;
+
+            case eTraceEventTick:
+                prvEmitInstant( &pxEvents[ xIndex ], 0 );
+                break;
+
+            default:
+                prvEmitInstant( &pxEvents[ xIndex ], ( pxCurrent != NULL ) ? pxCurrent->ulTrackId : 0U );
+                break;
+        }
+    }
+
+    /* Track names, sorted by creation. */
+    prvBeginEvent( "M", ullStartTime, 0 );
+    printf( ",\"name\":\"thread_name\",\"args\":{\"name\":\"Kernel / ISR\"}}" );
+
+    for( ulCurrentIndex = 0; ulCurrentIndex < ulTaskCount; ulCurrentIndex++ )
+    {
+        prvBeginEvent( "M", ullStartTime, pxTasks[ ulCurrentIndex ].ulTrackId );
+        printf( ",\"name\":\"thread_name\",\"args\":{\"name\":\"" );
+        prvPrintTaskName( &pxTasks[ ulCurrentIndex ] );
+        printf( "\"}}" );
+    }
+
+    printf( "\n]}\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintSummary( void )
+{
+    const TaskState_t * pxTask;
+    uint32_t ulIndex;
+
+    fprintf( stderr, "%-20s %10s %14s %14s\n", "Task", "Slices", "Avg ready us", "Max ready us" );
+
+    for( ulIndex = 0; ulIndex < ulTaskCount; ulIndex++ )
+    {
+        pxTask = &pxTasks[ ulIndex ];
+
+        if( pxTask->pxName != NULL )
+        {
+            fprintf( stderr, "%-20.*s", ( int ) traceRECORDER_NAME_LENGTH, pxTask->pxName->cName );
+        }
+        else
+        {
+            fprintf( stderr, "0x%-18" PRIx64, pxTask->ullObject );
+        }
+
+        fprintf( stderr, " %10" PRIu64 " %14.3f %14.3f\n", pxTask->ullSlices,
+                 ( pxTask->ullLatencySamples > 0U ) ? ( double ) pxTask->ullLatencyTotalTicks * dNsPerTick / ( double ) pxTask->ullLatencySamples / 1000.0 : 0.0,
+                 ( double ) pxTask->ullLatencyMaxTicks * dNsPerTick / 1000.0 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    TraceFileHeader_t xHeader;
+    TraceBufferHeader_t xBufferHeader;
+    Event_t * pxEvents = NULL;
+    size_t xEventCount = 0;
+    uint64_t ullOverwritten = 0;
+    uint32_t ulBuffer, ulRecord;
+    FILE * pxFile;
+
+    if( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s <trace file>\n", argv[ 0 ] );
+        return 2;
+    }
+
+    pxFile = fopen( argv[ 1 ], "rb" );
+
+    if( pxFile == NULL )
+    {
+        prvDie( "cannot open trace file" );
+    }
+
+    prvRead( &xHeader, sizeof( xHeader ), pxFile );
+
+    if( ( memcmp( xHeader.cMagic, traceRECORDER_MAGIC, sizeof( xHeader.cMagic ) ) != 0 ) ||
+        ( xHeader.ulRecordSize != sizeof( TraceRecord_t ) ) )
+    {
+        prvDie( "not a trace recorder file, or written by a different version" );
+    }
+
+    if( ( xHeader.ullLastTicks > xHeader.ullFirstTicks ) && ( xHeader.ullLastNs > xHeader.ullFirstNs ) )
+    {
+        dNsPerTick = ( double ) ( xHeader.ullLastNs - xHeader.ullFirstNs ) /
+                     ( double ) ( xHeader.ullLastTicks - xHeader.ullFirstTicks );
+    }
+
+    ulNameCount = xHeader.ulObjectCount;
+    pxNames = calloc( ulNameCount + 1U, sizeof( TraceObjectName_t ) );
+
+    if( pxNames == NULL )
+    {
+        prvDie( "out of memory" );
+    }
+
+    prvRead( pxNames, ulNameCount * sizeof( TraceObjectName_t ), pxFile );
+
+    for( ulBuffer = 0; ulBuffer < xHeader.ulBufferCount; ulBuffer++ )
+    {
+        prvRead( &xBufferHeader, sizeof( xBufferHeader ), pxFile );
+        pxEvents = realloc( pxEvents, ( xEventCount + xBufferHeader.ulRecords + 1U ) * sizeof( Event_t ) );
+
+        if( pxEvents == NULL )
+        {
+            prvDie( "out of memory" );
+        }
+
+        for( ulRecord = 0; ulRecord < xBufferHeader.ulRecords; ulRecord++ )
+        {
+            prvRead( &pxEvents[ xEventCount ].xRecord, sizeof( TraceRecord_t ), pxFile );
+            pxEvents[ xEventCount ].ullSequence = xEventCount;
+            xEventCount++;
+        }
+
+        ullOverwritten += xBufferHeader.ullOverwritten;
+    }
+
+    fclose( pxFile );
+
+    qsort( pxEvents, xEventCount, sizeof( Event_t ), prvCompareEvents );
+    prvConvert( pxEvents, xEventCount );
+    prvPrintSummary();
+
+    fprintf( stderr, "%zu events from %" PRIu32 " threads, %" PRIu64 " overwritten, %" PRIu32 " dropped\n",
+             xEventCount, xHeader.ulBufferCount, ullOverwritten, xHeader.ulDropped );
+
+    free( pxEvents );
+    free( pxNames );
+    free( pxTasks );
+
+    return 0;
+}